@@ -0,0 +1,399 @@
+#ifndef _Geometry_BVH_H
+#define _Geometry_BVH_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <assert.h>
+#include <Geometry/Ray.h>
+#include <Geometry/BoundingBox.h>
+#include <System/aligned_allocator.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	BVH
+	///
+	/// \brief	A bounding volume hierarchy built with the surface area heuristic (SAH). The hierarchy
+	/// 		is built on a set of primitives only described by their bounding boxes. Primitives are
+	/// 		identified by their index in the array provided to BVH::build, the intersection with
+	/// 		the primitives themselves is delegated to a functor during the traversal.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class BVH
+	{
+	public:
+		/// \brief	Number of bins used to evaluate the surface area heuristic.
+		static const int binCount = 16 ;
+		/// \brief	Maximum depth of a leaf (the builder switches to median splits before reaching it).
+		static const int maxDepth = 64 ;
+		/// \brief	Maximum size of the traversal stack (at most one entry per level).
+		static const int stackSize = maxDepth ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Node
+		///
+		/// \brief	A node of the hierarchy. Nodes are stored in depth first order: the first child of an
+		/// 		interior node directly follows its parent.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct Node
+		{
+			/// \brief	The bounding box of the node.
+			BoundingBox m_box ;
+			/// \brief	Index of the second child (interior node) or of the first primitive (leaf).
+			int m_offset ;
+			/// \brief	Number of primitives in the leaf (0 for an interior node).
+			int m_count ;
+			/// \brief	The split axis (interior node).
+			int m_axis ;
+		} ;
+
+	protected:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Bin
+		///
+		/// \brief	A bin used during SAH evaluation.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct Bin
+		{
+			/// \brief	Bounding box of the primitives in the bin.
+			BoundingBox m_box ;
+			/// \brief	Number of primitives in the bin.
+			int m_count ;
+
+			Bin() : m_count(0) {}
+		} ;
+
+		/// \brief	The nodes (the root is the first one).
+		::std::vector<Node, aligned_allocator<Node, 16> > m_nodes ;
+		/// \brief	The primitive indexes, referenced by the leaves.
+		::std::vector<int> m_primitives ;
+		/// \brief	The maximum number of primitives in a leaf.
+		int m_maxLeafSize ;
+		/// \brief	The cost of a node traversal (SAH).
+		float m_traversalCost ;
+		/// \brief	The cost of a primitive intersection (SAH).
+		float m_intersectionCost ;
+		/// \brief	Number of primitives intersected at once by the leaf intersector (SAH).
+		int m_blockSize ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int BVH::blockCount(int count) const
+		///
+		/// \brief	Number of primitive blocks needed to store count primitives.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	count	The number of primitives.
+		///
+		/// \return	The number of blocks.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int blockCount(int count) const
+		{ return (count+m_blockSize-1)/m_blockSize ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int BVH::buildNode(const BoundingBox * boxes, const Math::Vector3 * centers, int begin,
+		/// 	int end, int depth)
+		///
+		/// \brief	Recursively builds the node containing the primitives m_primitives[begin..end[. The
+		/// 		split is chosen among binCount candidate planes per axis by minimizing the SAH cost.
+		/// 		When the remaining levels before maxDepth are just enough to reach leaves by median
+		/// 		splits, median splits are used instead, so that degenerate SAH splits (many
+		/// 		coincident centers) cannot overflow the traversal stack.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	boxes  	The bounding boxes of the primitives.
+		/// \param	centers	The centers of the bounding boxes of the primitives.
+		/// \param	begin  	The first primitive.
+		/// \param	end	   	The primitive after the last one.
+		/// \param	depth  	The depth of the node (0 for the root).
+		///
+		/// \return	The index of the created node.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int buildNode(const BoundingBox * boxes, const Math::Vector3 * centers, int begin, int end, int depth)
+		{
+			int nodeIndex = (int)m_nodes.size() ;
+			m_nodes.push_back(Node()) ;
+
+			BoundingBox box ;
+			BoundingBox centerBox ;
+			for(int cpt=begin ; cpt<end ; ++cpt)
+			{
+				box.update(boxes[m_primitives[cpt]]) ;
+				centerBox.update(centers[m_primitives[cpt]]) ;
+			}
+			int count = end-begin ;
+			// Number of median splits needed to reach leaves of at most m_maxLeafSize primitives
+			int medianLevels = 0 ;
+			while(((long long)m_maxLeafSize<<medianLevels)<count) { ++medianLevels ; }
+			bool depthLimited = depth+medianLevels>=maxDepth ;
+
+			// Search of the best split (binned SAH)
+			float bestCost = ::std::numeric_limits<float>::max() ;
+			int bestAxis = -1 ;
+			int bestBin = -1 ;
+			for(int axis=0 ; axis<3 && count>1 && !depthLimited ; ++axis)
+			{
+				float extent = centerBox.maxVertex()[axis]-centerBox.minVertex()[axis] ;
+				float scale = binCount/extent ;
+				// Flat (or denormal) extent: the bins cannot be computed
+				if(extent<=0.0f || scale>::std::numeric_limits<float>::max()) { continue ; }
+				Bin bins[binCount] ;
+				for(int cpt=begin ; cpt<end ; ++cpt)
+				{
+					int index = m_primitives[cpt] ;
+					int bin = ::std::min(binCount-1, (int)((centers[index][axis]-centerBox.minVertex()[axis])*scale)) ;
+					bins[bin].m_count++ ;
+					bins[bin].m_box.update(boxes[index]) ;
+				}
+				// Sweep from the right to compute the cost of the right part of each split
+				float rightSurface[binCount] ;
+				int rightCount[binCount] ;
+				BoundingBox accumulated ;
+				int accumulatedCount = 0 ;
+				for(int bin=binCount-1 ; bin>0 ; --bin)
+				{
+					accumulated.update(bins[bin].m_box) ;
+					accumulatedCount += bins[bin].m_count ;
+					rightSurface[bin] = accumulated.surface() ;
+					rightCount[bin] = accumulatedCount ;
+				}
+				// Sweep from the left and evaluation of each split
+				accumulated = BoundingBox() ;
+				accumulatedCount = 0 ;
+				for(int bin=0 ; bin<binCount-1 ; ++bin)
+				{
+					accumulated.update(bins[bin].m_box) ;
+					accumulatedCount += bins[bin].m_count ;
+					if(accumulatedCount==0 || rightCount[bin+1]==0) { continue ; }
+					float cost = blockCount(accumulatedCount)*accumulated.surface()+blockCount(rightCount[bin+1])*rightSurface[bin+1] ;
+					if(cost<bestCost)
+					{
+						bestCost = cost ;
+						bestAxis = axis ;
+						bestBin = bin ;
+					}
+				}
+			}
+
+			float leafCost = m_intersectionCost*blockCount(count) ;
+			float splitCost = m_traversalCost+m_intersectionCost*bestCost/::std::max(box.surface(), ::std::numeric_limits<float>::min()) ;
+			int middle ;
+			if(bestAxis<0 || (count<=m_maxLeafSize && leafCost<=splitCost))
+			{
+				if(count<=m_maxLeafSize)
+				{
+					// Leaf creation
+					m_nodes[nodeIndex].m_box = box ;
+					m_nodes[nodeIndex].m_offset = begin ;
+					m_nodes[nodeIndex].m_count = count ;
+					m_nodes[nodeIndex].m_axis = 0 ;
+					return nodeIndex ;
+				}
+				// Too many primitives with the same center or maximum depth close: median split along
+				// the largest extent of the centers
+				Math::Vector3 extent = centerBox.maxVertex()-centerBox.minVertex() ;
+				bestAxis = (extent[0]>=extent[1] && extent[0]>=extent[2]) ? 0 : ((extent[1]>=extent[2]) ? 1 : 2) ;
+				middle = (begin+end)/2 ;
+				int * first = &m_primitives[0] ;
+				::std::nth_element(first+begin, first+middle, first+end, [&](int left, int right) -> bool
+				{
+					return centers[left][bestAxis]<centers[right][bestAxis] ;
+				}) ;
+			}
+			else
+			{
+				float scale = binCount/(centerBox.maxVertex()[bestAxis]-centerBox.minVertex()[bestAxis]) ;
+				float origin = centerBox.minVertex()[bestAxis] ;
+				int * first = &m_primitives[0] ;
+				middle = (int)(::std::partition(first+begin, first+end, [&](int index) -> bool
+				{
+					return ::std::min(binCount-1, (int)((centers[index][bestAxis]-origin)*scale))<=bestBin ;
+				})-first) ;
+			}
+
+			// Interior node creation
+			buildNode(boxes, centers, begin, middle, depth+1) ;
+			int second = buildNode(boxes, centers, middle, end, depth+1) ;
+			m_nodes[nodeIndex].m_box = box ;
+			m_nodes[nodeIndex].m_offset = second ;
+			m_nodes[nodeIndex].m_count = 0 ;
+			m_nodes[nodeIndex].m_axis = bestAxis ;
+			return nodeIndex ;
+		}
+
+	public:
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	BVH::BVH(int maxLeafSize = 4, float traversalCost = 1.0f, float intersectionCost = 1.0f,
+		/// 	int blockSize = 1)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	maxLeafSize			The maximum number of primitives in a leaf.
+		/// \param	traversalCost   	The cost of a node traversal (SAH).
+		/// \param	intersectionCost	The cost of a primitive intersection (SAH), or of a block of
+		/// 							primitives if blockSize is greater than 1.
+		/// \param	blockSize			The number of primitives intersected at once (see TriangleBlock).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		BVH(int maxLeafSize = 4, float traversalCost = 1.0f, float intersectionCost = 1.0f, int blockSize = 1)
+			: m_maxLeafSize(maxLeafSize), m_traversalCost(traversalCost), m_intersectionCost(intersectionCost), m_blockSize(blockSize)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void BVH::build(const ::std::vector<BoundingBox, aligned_allocator<BoundingBox, 16> > & boxes)
+		///
+		/// \brief	Builds the hierarchy on the primitives described by the provided bounding boxes.
+		/// 		Primitive i is the primitive bounded by boxes[i].
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	boxes	The bounding boxes of the primitives.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void build(const ::std::vector<BoundingBox, aligned_allocator<BoundingBox, 16> > & boxes)
+		{
+			m_nodes.clear() ;
+			m_primitives.resize(boxes.size()) ;
+			if(boxes.empty()) { return ; }
+			::std::vector<Math::Vector3, aligned_allocator<Math::Vector3, 16> > centers(boxes.size()) ;
+			for(int cpt=0 ; cpt<(int)boxes.size() ; ++cpt)
+			{
+				m_primitives[cpt] = cpt ;
+				centers[cpt] = boxes[cpt].center() ;
+			}
+			m_nodes.reserve(2*boxes.size()) ;
+			buildNode(&boxes[0], &centers[0], 0, (int)boxes.size(), 0) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool BVH::empty() const
+		///
+		/// \brief	Tests if the hierarchy is empty.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if empty, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool empty() const
+		{ return m_nodes.empty() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::vector<Node, aligned_allocator<Node, 16> > & BVH::getNodes() const
+		///
+		/// \brief	Gets the nodes of the hierarchy.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The nodes.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::vector<Node, aligned_allocator<Node, 16> > & getNodes() const
+		{ return m_nodes ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::vector<int> & BVH::getPrimitives() const
+		///
+		/// \brief	Gets the primitive indexes referenced by the leaves.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The primitives.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::vector<int> & getPrimitives() const
+		{ return m_primitives ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LeafIntersector> bool BVH::intersect(Ray const & ray, float & tMax,
+		/// 	LeafIntersector & intersector) const
+		///
+		/// \brief	Computes the nearest intersection between a ray and the primitives of the hierarchy.
+		/// 		Nodes are visited front to back and skipped as soon as they are farther than the
+		/// 		nearest intersection found so far.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Functor with signature bool (int primitive, float & tMax). It
+		/// 						returns true and updates tMax if the primitive is intersected
+		/// 						nearer than tMax.
+		/// \param	ray					The ray.
+		/// \param [in,out]	tMax		The maximum distance on the ray, updated with the nearest
+		/// 							intersection.
+		/// \param [in,out]	intersector	The primitive intersector.
+		///
+		/// \return	true if an intersection has been found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LeafIntersector>
+		bool intersect(Ray const & ray, float & tMax, LeafIntersector & intersector) const
+		{
+			if(m_nodes.empty()) { return false ; }
+			float tEntry ;
+			if(!m_nodes[0].m_box.intersect(ray, 0.0f, tMax, tEntry)) { return false ; }
+
+			bool found = false ;
+			::std::pair<int, float> stack[stackSize] ;
+			int top = 0 ;
+			int current = 0 ;
+			while(true)
+			{
+				const Node & node = m_nodes[current] ;
+				if(node.m_count>0)
+				{
+					for(int cpt=node.m_offset, end=node.m_offset+node.m_count ; cpt<end ; ++cpt)
+					{
+						found |= intersector(m_primitives[cpt], tMax) ;
+					}
+				}
+				else
+				{
+					int first = current+1 ;
+					int second = node.m_offset ;
+					float tFirst, tSecond ;
+					bool hitFirst = m_nodes[first].m_box.intersect(ray, 0.0f, tMax, tFirst) ;
+					bool hitSecond = m_nodes[second].m_box.intersect(ray, 0.0f, tMax, tSecond) ;
+					if(hitFirst && hitSecond)
+					{
+						if(tSecond<tFirst)
+						{
+							::std::swap(first, second) ;
+							::std::swap(tFirst, tSecond) ;
+						}
+						assert(top<stackSize) ;
+						stack[top++] = ::std::make_pair(second, tSecond) ;
+						current = first ;
+						continue ;
+					}
+					if(hitFirst) { current = first ; continue ; }
+					if(hitSecond) { current = second ; continue ; }
+				}
+				// Next node on the stack, nodes farther than the nearest intersection are skipped
+				do
+				{
+					if(top==0) { return found ; }
+					--top ;
+				}
+				while(stack[top].second>tMax) ;
+				current = stack[top].first ;
+			}
+		}
+	} ;
+}
+
+#endif
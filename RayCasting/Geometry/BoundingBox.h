@@ -1,10 +1,20 @@
 #ifndef _Geometry_BoundingBox_H
 #define _Geometry_BoundingBox_H
 
-#include <Geometry/Geometry.h>
+#include <limits>
+#include <algorithm>
+#include <deque>
+#include <Math/Vector3.h>
+#include <Geometry/Ray.h>
+#include <Geometry/Triangle.h>
+#include <System/aligned_allocator.h>
 
 namespace Geometry
 {
+	// Geometry owns an acceleration structure made of bounding boxes, methods related to geometries
+	// are defined at the end of Geometry/Geometry.h.
+	class Geometry ;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// \class	BoundingBox
 	///
@@ -20,6 +30,21 @@ namespace Geometry
 		Math::Vector3 m_bounds[2] ;
 	public:
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	BoundingBox::BoundingBox()
+		///
+		/// \brief	Default constructor. Initializes an empty bounding box (min = +max float, max = -max 
+		/// 		float) that can be enlarged with the update methods.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		BoundingBox()
+		{
+			m_bounds[0] = Math::Vector3(::std::numeric_limits<float>::max(), ::std::numeric_limits<float>::max(), ::std::numeric_limits<float>::max()) ;
+			m_bounds[1] = Math::Vector3(-::std::numeric_limits<float>::max(), -::std::numeric_limits<float>::max(), -::std::numeric_limits<float>::max()) ;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	BoundingBox::BoundingBox(Geometry const & geometry)
 		///
@@ -30,10 +55,7 @@ namespace Geometry
 		///
 		/// \param	geometry	The geometry.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		BoundingBox(Geometry const & geometry)
-		{
-			set(geometry);
-		}
+		inline BoundingBox(Geometry const & geometry) ;
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	BoundingBox::BoundingBox(Math::Vector3 const & minVertex, Math::Vector3 const & maxVertex)
@@ -62,13 +84,7 @@ namespace Geometry
 		///
 		/// \param	geometry	The geometry.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		void set( Geometry const &geometry ) 
-		{
-			const std::deque<Math::Vector3, aligned_allocator<Math::Vector3, 16> > & vertices(geometry.getVertices()) ;
-			m_bounds[0] = vertices[0] ;
-			m_bounds[1] = vertices[0] ;
-			update(geometry) ;
-		}
+		inline void set( Geometry const &geometry ) ;
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	void BoundingBox::update(Geometry const & geometry)
@@ -80,15 +96,7 @@ namespace Geometry
 		///
 		/// \param	geometry	The geometry.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		void update(Geometry const & geometry)
-		{
-			const std::deque<Math::Vector3, aligned_allocator<Math::Vector3, 16> > & vertices(geometry.getVertices()) ;
-			for(auto it=vertices.begin(), end=vertices.end() ; it!=end ; ++it)
-			{
-				m_bounds[0] = m_bounds[0].simdMin(*it) ;
-				m_bounds[1] = m_bounds[1].simdMax(*it) ;
-			}
-		}
+		inline void update(Geometry const & geometry) ;
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	void BoundingBox::update(BoundingBox const & boundingBox)
@@ -106,6 +114,114 @@ namespace Geometry
 			m_bounds[1] = m_bounds[1].simdMax(boundingBox.m_bounds[1]) ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void BoundingBox::update(Math::Vector3 const & point)
+		///
+		/// \brief	Updates this bounding box to bound the given point.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	point	The point.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void update(Math::Vector3 const & point)
+		{
+			m_bounds[0] = m_bounds[0].simdMin(point) ;
+			m_bounds[1] = m_bounds[1].simdMax(point) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void BoundingBox::update(Triangle const & triangle)
+		///
+		/// \brief	Updates this bounding box to bound the given triangle.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	triangle	The triangle.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void update(Triangle const & triangle)
+		{
+			update(triangle.vertex(0)) ;
+			update(triangle.vertex(1)) ;
+			update(triangle.vertex(2)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Math::Vector3 & BoundingBox::minVertex() const
+		///
+		/// \brief	Gets the smallest coordinates on X, Y, Z axes.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Math::Vector3 & minVertex() const
+		{ return m_bounds[0] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Math::Vector3 & BoundingBox::maxVertex() const
+		///
+		/// \brief	Gets the highest coordinates on X, Y, Z axes.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Math::Vector3 & maxVertex() const
+		{ return m_bounds[1] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool BoundingBox::isEmpty() const
+		///
+		/// \brief	Tests if this bounding box is empty (i.e. does not bound anything).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if empty, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool isEmpty() const
+		{
+			return (m_bounds[0][0]>m_bounds[1][0]) || (m_bounds[0][1]>m_bounds[1][1]) || (m_bounds[0][2]>m_bounds[1][2]) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 BoundingBox::center() const
+		///
+		/// \brief	Gets the center of the bounding box.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 center() const
+		{ return (m_bounds[0]+m_bounds[1])*0.5f ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float BoundingBox::surface() const
+		///
+		/// \brief	Gets the surface area of the bounding box (0 if the box is empty). This is the 
+		/// 		quantity used by the surface area heuristic.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The surface area.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float surface() const
+		{
+			if(isEmpty())
+			{
+				return 0.0f ;
+			}
+			Math::Vector3 diagonal = m_bounds[1]-m_bounds[0] ;
+			return 2.0f*(diagonal[0]*diagonal[1]+diagonal[1]*diagonal[2]+diagonal[2]*diagonal[0]) ;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	bool BoundingBox::intersect(const Ray & ray) const
 		///
@@ -154,7 +270,53 @@ namespace Geometry
 			}
 			return (tmin[0]<t1) && (tmax[0]>t0) ;
 		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool BoundingBox::intersect(const Ray & ray, float t0, float t1, float & tEntry) const
+		///
+		/// \brief	Tests if the provided ray intersects this box within [t0;t1] and computes the distance
+		/// 		at which the ray enters the box. Used to visit the nearest nodes of an acceleration 
+		/// 		structure first.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray			  	The ray.
+		/// \param	t0			  	The minimum distance on the ray.
+		/// \param	t1			  	The maximum distance on the ray.
+		/// \param [out]	tEntry	The distance at which the ray enters the box (clamped to t0).
+		///
+		/// \return	true if an intersection is found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool intersect(const Ray & ray, float t0, float t1, float & tEntry) const
+		{
+			const int * sign = ray.getSign() ;
+			const Math::Vector3 & source = ray.source() ;
+			const Math::Vector3 & invDirection = ray.invDirection() ;
+			float tmin = (m_bounds[sign[0]][0]-source[0])*invDirection[0] ;
+			float tmax = (m_bounds[1-sign[0]][0]-source[0])*invDirection[0] ;
+			float tymin = (m_bounds[sign[1]][1]-source[1])*invDirection[1] ;
+			float tymax = (m_bounds[1-sign[1]][1]-source[1])*invDirection[1] ;
+			if((tmin>tymax) || (tymin>tmax))
+			{
+				return false ;
+			}
+			if(tymin>tmin) { tmin = tymin ; }
+			if(tymax<tmax) { tmax = tymax ; }
+			float tzmin = (m_bounds[sign[2]][2]-source[2])*invDirection[2] ;
+			float tzmax = (m_bounds[1-sign[2]][2]-source[2])*invDirection[2] ;
+			if((tmin>tzmax) || (tzmin>tmax))
+			{
+				return false ;
+			}
+			if(tzmin>tmin) { tmin = tzmin ; }
+			if(tzmax<tmax) { tmax = tzmax ; }
+			tEntry = ::std::max(tmin, t0) ;
+			return (tmin<=t1) && (tmax>=t0) ;
+		}
 	} ;
 }
 
+#include <Geometry/Geometry.h>
+
 #endif
\ No newline at end of file
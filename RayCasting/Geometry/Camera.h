@@ -139,6 +139,36 @@ namespace Geometry
 		{
 			return Ray(m_position, m_upLeftPoint+m_widthVector*coordX+m_heightVector*coordY-m_position) ;
 		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class RayContainer> void Camera::getRays(float coordX, float coordY,
+		/// 	float stepX, float stepY, int columns, int rows, RayContainer & rays) const
+		///
+		/// \brief	Get the primary rays of a tile of pixels (row major order), used to build packets of
+		/// 		coherent rays (see RayPacket).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	coordX			X coordinate of the first ray in the projection rectangle.
+		/// \param	coordY			Y coordinate of the first ray in the projection rectangle.
+		/// \param	stepX			Step between two columns.
+		/// \param	stepY			Step between two rows.
+		/// \param	columns			Number of columns of the tile.
+		/// \param	rows			Number of rows of the tile.
+		/// \param [out]	rays	The container receiving the rays.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class RayContainer>
+		void getRays(float coordX, float coordY, float stepX, float stepY, int columns, int rows, RayContainer & rays) const
+		{
+			for(int row=0 ; row<rows ; ++row)
+			{
+				for(int column=0 ; column<columns ; ++column)
+				{
+					rays.push_back(getRay(coordX+column*stepX, coordY+row*stepY)) ;
+				}
+			}
+		}
 	} ;
 }
 
@@ -0,0 +1,397 @@
+#ifndef _Geometry_Denoiser_H
+#define _Geometry_Denoiser_H
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+#include <emmintrin.h>
+#include <Geometry/RGBColor.h>
+#include <Geometry/FrameBuffer.h>
+#include <Math/Vector3.h>
+#include <Math/sse/Float4_approximations.h>
+#include <System/aligned_allocator.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Denoiser
+	///
+	/// \brief	Edge avoiding -trous wavelet filter (H. Dammertz et al., "Edge-Avoiding -Trous
+	/// 		Wavelet Transform for fast Global Illumination Filtering", HPG 2010) applied to the
+	/// 		accumulated radiance of a frame buffer.
+	///
+	/// 		The features of the first hits (diffuse albedo, normal and depth, see
+	/// 		Denoiser::setFeatures) guide the filter: the radiance is divided by the albedo (so that
+	/// 		textures are not blurred), then filtered by iterations of a 5x5 B3 spline kernel whose
+	/// 		taps are spaced by 1, 2, 4... pixels. The weight of a tap decreases with the difference
+	/// 		of (demodulated) color relatively to the standard error of the pixel, the difference of
+	/// 		normal and the relative difference of depth. The filtered radiance is finally multiplied
+	/// 		by the albedo.
+	///
+	/// 		Buffers are stored channel by channel, with a border of invalid pixels wide enough for
+	/// 		the largest step: four consecutive pixels of a line are filtered together with SSE
+	/// 		instructions, lines are distributed to the threads.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Denoiser
+	{
+	public:
+		/// \brief	A channel of the buffers.
+		typedef ::std::vector<float, aligned_allocator<float, 16> > Channel ;
+
+		/// \brief	The maximum number of iterations of the filter.
+		static const int maxIterations = 5 ;
+
+		/// \brief	The border of the buffers (the largest offset of a tap).
+		static const int border = 2<<(maxIterations-1) ;
+
+	protected:
+		/// \brief	The width of the image.
+		int m_width ;
+		/// \brief	The height of the image.
+		int m_height ;
+		/// \brief	The number of values of a line of the buffers (border included, multiple of 4).
+		int m_stride ;
+		/// \brief	The albedo of the first hits (1 where the surface has no diffuse albedo).
+		Channel m_albedo[3] ;
+		/// \brief	The normal of the first hits (oriented toward the camera).
+		Channel m_normal[3] ;
+		/// \brief	The distance of the first hits.
+		Channel m_depth ;
+		/// \brief	1 for the pixels of the image whose primary ray hit the scene, 0 for the background
+		/// 		and the border.
+		Channel m_valid ;
+		/// \brief	The demodulated radiance (source and destination of the iterations).
+		Channel m_color[2][3] ;
+		/// \brief	The variance of the mean demodulated luminance of the pixels.
+		Channel m_variance ;
+		/// \brief	The number of iterations.
+		int m_iterations ;
+		/// \brief	The tolerance to color differences (in standard errors).
+		float m_colorPhi ;
+		/// \brief	The tolerance to normal differences.
+		float m_normalPhi ;
+		/// \brief	The tolerance to relative depth differences.
+		float m_depthPhi ;
+		/// \brief	The filtered image.
+		::std::vector<RGBColor> m_image ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int Denoiser::index(int x, int y) const
+		///
+		/// \brief	Computes the index of a pixel in the channels.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	The index.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int index(int x, int y) const
+		{
+			return (y+border)*m_stride+border+x ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Denoiser::filter(int source, int step, float colorScale)
+		///
+		/// \brief	One iteration of the filter, from m_color[source] to m_color[1-source].
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	source	  	The source buffer.
+		/// \param	step	  	The spacing of the taps.
+		/// \param	colorScale	The scale of the color tolerance for this iteration.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void filter(int source, int step, float colorScale)
+		{
+			const float kernel[5] = { 1.0f/16.0f, 1.0f/4.0f, 3.0f/8.0f, 1.0f/4.0f, 1.0f/16.0f } ;
+			const Channel * input = m_color[source] ;
+			Channel * output = m_color[1-source] ;
+			const __m128 colorFactor = _mm_set1_ps(m_colorPhi*m_colorPhi*colorScale) ;
+			const __m128 normalFactor = _mm_set1_ps(1.0f/(m_normalPhi*m_normalPhi)) ;
+			const __m128 depthFactor = _mm_set1_ps(m_depthPhi) ;
+			const __m128 epsilon = _mm_set1_ps(1e-6f) ;
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)) ;
+#pragma omp parallel for schedule(dynamic, 4)
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; x+=4)
+				{
+					int p = index(x, y) ;
+					__m128 color[3], normal[3] ;
+					for(int channel=0 ; channel<3 ; ++channel)
+					{
+						color[channel] = _mm_load_ps(&input[channel][p]) ;
+						normal[channel] = _mm_load_ps(&m_normal[channel][p]) ;
+					}
+					// Invalid pixels (background, border) keep their color
+					__m128 valid = _mm_cmpgt_ps(_mm_load_ps(&m_valid[p]), _mm_setzero_ps()) ;
+					if(_mm_movemask_ps(valid)==0)
+					{
+						for(int channel=0 ; channel<3 ; ++channel)
+						{
+							_mm_store_ps(&output[channel][p], color[channel]) ;
+						}
+						continue ;
+					}
+					__m128 depth = _mm_load_ps(&m_depth[p]) ;
+					__m128 variance = _mm_load_ps(&m_variance[p]) ;
+					__m128 sum[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() } ;
+					__m128 weightSum = _mm_setzero_ps() ;
+					for(int dy=-2 ; dy<=2 ; ++dy)
+					{
+						for(int dx=-2 ; dx<=2 ; ++dx)
+						{
+							int q = p+dy*step*m_stride+dx*step ;
+							__m128 colorDistance = _mm_setzero_ps() ;
+							__m128 normalDistance = _mm_setzero_ps() ;
+							__m128 tapColor[3] ;
+							for(int channel=0 ; channel<3 ; ++channel)
+							{
+								tapColor[channel] = _mm_loadu_ps(&input[channel][q]) ;
+								__m128 difference = _mm_sub_ps(color[channel], tapColor[channel]) ;
+								colorDistance = _mm_add_ps(colorDistance, _mm_mul_ps(difference, difference)) ;
+								difference = _mm_sub_ps(normal[channel], _mm_loadu_ps(&m_normal[channel][q])) ;
+								normalDistance = _mm_add_ps(normalDistance, _mm_mul_ps(difference, difference)) ;
+							}
+							__m128 tapDepth = _mm_loadu_ps(&m_depth[q]) ;
+							// Weights do not need accurate divisions (approximate reciprocals)
+							__m128 depthDistance = _mm_mul_ps(_mm_and_ps(_mm_sub_ps(depth, tapDepth), absMask),
+															  _mm_rcp_ps(_mm_add_ps(_mm_mul_ps(depthFactor, _mm_min_ps(depth, tapDepth)), epsilon))) ;
+							// The color tolerance uses the variances of both pixels (symmetric weights)
+							__m128 colorTolerance = _mm_add_ps(_mm_mul_ps(colorFactor, _mm_add_ps(variance, _mm_loadu_ps(&m_variance[q]))), epsilon) ;
+							__m128 exponent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(colorDistance, _mm_rcp_ps(colorTolerance)), _mm_mul_ps(normalDistance, normalFactor)), depthDistance) ;
+							__m128 weight = _mm_mul_ps(_mm_set1_ps(kernel[dy+2]*kernel[dx+2]), _mm_loadu_ps(&m_valid[q])) ;
+							// Clamped so that negligible weights do not produce denormals (slow arithmetic)
+							weight = _mm_mul_ps(weight, Math::sse::exp4(_mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), exponent), _mm_set1_ps(-30.0f)))) ;
+							for(int channel=0 ; channel<3 ; ++channel)
+							{
+								sum[channel] = _mm_add_ps(sum[channel], _mm_mul_ps(weight, tapColor[channel])) ;
+							}
+							weightSum = _mm_add_ps(weightSum, weight) ;
+						}
+					}
+					__m128 inverseWeight = _mm_div_ps(_mm_set1_ps(1.0f), _mm_or_ps(weightSum, _mm_andnot_ps(valid, _mm_set1_ps(1.0f)))) ;
+					for(int channel=0 ; channel<3 ; ++channel)
+					{
+						__m128 filtered = _mm_mul_ps(sum[channel], inverseWeight) ;
+						_mm_store_ps(&output[channel][p], _mm_or_ps(_mm_and_ps(valid, filtered), _mm_andnot_ps(valid, color[channel]))) ;
+					}
+				}
+			}
+		}
+
+	public:
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Denoiser::Denoiser()
+		///
+		/// \brief	Default constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Denoiser()
+			: m_width(0), m_height(0), m_stride(0), m_iterations(maxIterations), m_colorPhi(2.0f), m_normalPhi(0.5f), m_depthPhi(0.1f)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Denoiser::setParameters(int iterations, float colorPhi, float normalPhi,
+		/// 	float depthPhi)
+		///
+		/// \brief	Sets the parameters of the filter.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	iterations	The number of iterations (at most maxIterations, default 5).
+		/// \param	colorPhi  	The tolerance to color differences, in standard errors of the pixel
+		/// 					(default 2).
+		/// \param	normalPhi 	The tolerance to normal differences (default 0.5).
+		/// \param	depthPhi  	The tolerance to relative depth differences (default 0.1).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setParameters(int iterations, float colorPhi, float normalPhi, float depthPhi)
+		{
+			m_iterations = ::std::max(0, ::std::min(iterations, (int)maxIterations)) ;
+			m_colorPhi = colorPhi ;
+			m_normalPhi = normalPhi ;
+			m_depthPhi = depthPhi ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Denoiser::resize(int width, int height)
+		///
+		/// \brief	Resizes the buffers and clears the features.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	width 	The width of the image.
+		/// \param	height	The height of the image.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void resize(int width, int height)
+		{
+			m_width = width ;
+			m_height = height ;
+			m_stride = border+(width+3)/4*4+border ;
+			size_t size = (size_t)(height+2*border)*m_stride ;
+			for(int channel=0 ; channel<3 ; ++channel)
+			{
+				m_albedo[channel].assign(size, 1.0f) ;
+				m_normal[channel].assign(size, 0.0f) ;
+				m_color[0][channel].assign(size, 0.0f) ;
+				m_color[1][channel].assign(size, 0.0f) ;
+			}
+			m_depth.assign(size, 0.0f) ;
+			m_variance.assign(size, 0.0f) ;
+			m_valid.assign(size, 0.0f) ;
+			for(int y=0 ; y<height ; ++y)
+			{
+				::std::fill(m_valid.begin()+index(0, y), m_valid.begin()+index(width, y), 1.0f) ;
+			}
+			m_image.resize((size_t)width*height) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Denoiser::setFeatures(int x, int y, RGBColor const & albedo,
+		/// 	Math::Vector3 const & normal, float depth)
+		///
+		/// \brief	Sets the features of the first hit of a pixel. Can be called concurrently for
+		/// 		different pixels.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	  	The column of the pixel.
+		/// \param	y	  	The line of the pixel.
+		/// \param	albedo	The diffuse albedo of the surface.
+		/// \param	normal	The normal of the surface, oriented toward the camera.
+		/// \param	depth 	The distance of the hit.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setFeatures(int x, int y, RGBColor const & albedo, Math::Vector3 const & normal, float depth)
+		{
+			int pixel = index(x, y) ;
+			m_valid[pixel] = 1.0f ;
+			for(int channel=0 ; channel<3 ; ++channel)
+			{
+				// Channels without diffuse albedo (mirrors, glass, lights) are not demodulated
+				m_albedo[channel][pixel] = albedo[channel]>0.01f ? albedo[channel] : 1.0f ;
+				m_normal[channel][pixel] = normal[channel] ;
+			}
+			m_depth[pixel] = depth ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Denoiser::setBackground(int x, int y)
+		///
+		/// \brief	Marks a pixel whose primary ray missed the scene: it is neither filtered nor used to
+		/// 		filter its neighbours (its color may come from the antialiased edge of an object).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setBackground(int x, int y)
+		{
+			int pixel = index(x, y) ;
+			m_valid[pixel] = 0.0f ;
+			for(int channel=0 ; channel<3 ; ++channel)
+			{
+				m_albedo[channel][pixel] = 1.0f ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Denoiser::denoise(FrameBuffer const & frameBuffer)
+		///
+		/// \brief	Filters the radiance accumulated in a frame buffer (same size as the features).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	frameBuffer	The frame buffer.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void denoise(FrameBuffer const & frameBuffer)
+		{
+#pragma omp parallel for
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					int pixel = index(x, y) ;
+					RGBColor color = frameBuffer.color(x, y) ;
+					RGBColor albedo(m_albedo[0][pixel], m_albedo[1][pixel], m_albedo[2][pixel]) ;
+					for(int channel=0 ; channel<3 ; ++channel)
+					{
+						m_color[0][channel][pixel] = color[channel]/albedo[channel] ;
+					}
+					float albedoLuminance = FrameBuffer::luminance(albedo) ;
+					int count = ::std::max(1, frameBuffer.sampleCount(x, y)) ;
+					m_color[1][0][pixel] = frameBuffer.variance(x, y)/count/(albedoLuminance*albedoLuminance) ;
+				}
+			}
+			// The variances estimated from a few samples are unreliable: they are averaged on 3x3 pixels
+#pragma omp parallel for
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					float sum = 0.0f ;
+					float count = 0.0f ;
+					for(int dy=-1 ; dy<=1 ; ++dy)
+					{
+						for(int dx=-1 ; dx<=1 ; ++dx)
+						{
+							int pixel = index(x+dx, y+dy) ;
+							sum += m_valid[pixel]*m_color[1][0][pixel] ;
+							count += m_valid[pixel] ;
+						}
+					}
+					m_variance[index(x, y)] = sum/::std::max(count, 1.0f) ;
+				}
+			}
+			int source = 0 ;
+			for(int iteration=0 ; iteration<m_iterations ; ++iteration)
+			{
+				filter(source, 1<<iteration, 1.0f/(1<<iteration)) ;
+				source = 1-source ;
+			}
+#pragma omp parallel for
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					int pixel = index(x, y) ;
+					m_image[y*m_width+x] = RGBColor(m_color[source][0][pixel]*m_albedo[0][pixel],
+													m_color[source][1][pixel]*m_albedo[1][pixel],
+													m_color[source][2][pixel]*m_albedo[2][pixel]) ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	::std::vector<RGBColor> const & Denoiser::image() const
+		///
+		/// \brief	Gets the image computed by the last call to Denoiser::denoise.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The colors of the pixels, line by line.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		::std::vector<RGBColor> const & image() const
+		{
+			return m_image ;
+		}
+	} ;
+}
+
+#endif
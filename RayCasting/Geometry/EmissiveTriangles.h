@@ -0,0 +1,161 @@
+#ifndef _Geometry_EmissiveTriangles_H
+#define _Geometry_EmissiveTriangles_H
+
+#include <vector>
+#include <math.h>
+#include <Math/Vector3.h>
+#include <Math/AliasTable.h>
+#include <Math/Sampler.h>
+#include <Math/Transform.h>
+#include <Geometry/Triangle.h>
+#include <Geometry/RGBColor.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	EmissiveTriangles
+	///
+	/// \brief	The registry of the triangles whose material emits light (Material::emissiveColor),
+	/// 		used to sample points on the light sources (next event estimation). Triangles are
+	/// 		chosen with an alias table weighted by their area, so that sampled points are uniformly
+	/// 		distributed on the emissive surfaces. The triangles of the shared meshes are registered
+	/// 		once per instance, with the transform of the instance.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class EmissiveTriangles
+	{
+	protected:
+		/// \brief	The emissive triangles.
+		::std::vector<const Triangle *> m_triangles ;
+		/// \brief	The transform of the instance of each triangle (NULL if the triangle is in world space).
+		::std::vector<const Math::Transform *> m_transforms ;
+		/// \brief	The normal of the emissive triangles (in world space).
+		::std::vector<Math::Vector3> m_normals ;
+		/// \brief	The area of the emissive triangles.
+		::std::vector<float> m_areas ;
+		/// \brief	The distribution of the triangles.
+		Math::AliasTable m_table ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void EmissiveTriangles::clear()
+		///
+		/// \brief	Removes all the triangles.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void clear()
+		{
+			m_triangles.clear() ;
+			m_transforms.clear() ;
+			m_normals.clear() ;
+			m_areas.clear() ;
+			m_table.build(m_areas) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void EmissiveTriangles::add(Triangle const & triangle,
+		/// 	const Math::Transform * transform = NULL)
+		///
+		/// \brief	Registers a triangle if its material is emissive. The triangle (and its transform)
+		/// 		must stay at the same address until the next call to EmissiveTriangles::clear.
+		/// 		EmissiveTriangles::build should be called once all the triangles are added.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	triangle 	The triangle.
+		/// \param	transform	The transform of the instance of the triangle (NULL if the triangle is in
+		/// 					world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void add(Triangle const & triangle, const Math::Transform * transform = NULL)
+		{
+			if(triangle.material()->emissiveColor()==RGBColor()) { return ; }
+			Math::Vector3 normal = triangle.normal() ;
+			Math::Vector3 cross ;
+			if(transform==NULL)
+			{
+				cross = (triangle.vertex(1)-triangle.vertex(0))^(triangle.vertex(2)-triangle.vertex(0)) ;
+			}
+			else
+			{
+				Math::Vector3 vertex0 = transform->toWorld(triangle.vertex(0)) ;
+				cross = (transform->toWorld(triangle.vertex(1))-vertex0)^(transform->toWorld(triangle.vertex(2))-vertex0) ;
+				normal = cross.normalized() ;
+			}
+			float area = cross.norm()*0.5f ;
+			if(area<=0.0f) { return ; }
+			m_triangles.push_back(&triangle) ;
+			m_transforms.push_back(transform) ;
+			m_normals.push_back(normal) ;
+			m_areas.push_back(area) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void EmissiveTriangles::build()
+		///
+		/// \brief	Builds the distribution of the registered triangles.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void build()
+		{
+			m_table.build(m_areas) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool EmissiveTriangles::empty() const
+		///
+		/// \brief	Tests if the scene contains emissive triangles.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if there is no emissive triangle.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool empty() const
+		{ return m_table.empty() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Triangle * EmissiveTriangles::sample(Math::SampleStream & samples,
+		/// 	Math::Vector3 & point, Math::Vector3 & normal, float & pdf,
+		/// 	const Math::Transform * & transform) const
+		///
+		/// \brief	Samples a point uniformly distributed on the emissive surfaces.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param [in,out]	samples	 	The samples (three dimensions are used).
+		/// \param [out]	point		 	The sampled point (in world space).
+		/// \param [out]	normal	 	The normal of the triangle (in world space).
+		/// \param [out]	pdf			 	The probability density of the point (per unit area).
+		/// \param [out]	transform	The transform of the instance of the triangle (NULL if the
+		/// 							triangle is in world space).
+		///
+		/// \return	The triangle containing the point (NULL if there is no emissive triangle).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Triangle * sample(Math::SampleStream & samples, Math::Vector3 & point, Math::Vector3 & normal, float & pdf, const Math::Transform * & transform) const
+		{
+			if(empty()) { return NULL ; }
+			int index = m_table.sample(samples.random()) ;
+			const Triangle * triangle = m_triangles[index] ;
+			// Uniform barycentric coordinates
+			float root = sqrt(samples.random()) ;
+			float b1 = 1.0f-root ;
+			float b2 = samples.random()*root ;
+			point = triangle->vertex(0)*(1.0f-b1-b2)+triangle->vertex(1)*b1+triangle->vertex(2)*b2 ;
+			transform = m_transforms[index] ;
+			if(transform!=NULL) { point = transform->toWorld(point) ; }
+			normal = m_normals[index] ;
+			pdf = m_table.pdf(index)/m_areas[index] ;
+			return triangle ;
+		}
+	} ;
+}
+
+#endif
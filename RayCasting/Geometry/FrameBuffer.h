@@ -0,0 +1,467 @@
+#ifndef _Geometry_FrameBuffer_H
+#define _Geometry_FrameBuffer_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <math.h>
+#include <assert.h>
+#include <Geometry/RGBColor.h>
+#include <Geometry/TileScheduler.h>
+#include <System/aligned_allocator.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	FrameBuffer
+	///
+	/// \brief	Accumulates the samples computed for the pixels of an image: sum of the samples per
+	/// 		channel, number of samples and running variance (Welford) of the luminance of the
+	/// 		samples.
+	///
+	/// 		Each channel is a single contiguous 64 bytes aligned allocation. Pixels are stored tile
+	/// 		by tile (tiles of the tile scheduler, line by line inside a tile): a tile is a contiguous
+	/// 		block whose size is a multiple of 64 bytes, so that threads rendering different tiles
+	/// 		never write in the same cache line.
+	///
+	/// 		For adaptive sampling, the frame buffer also flags the pixels that still need samples
+	/// 		(see FrameBuffer::updateActivePixels).
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class FrameBuffer
+	{
+	public:
+		/// \brief	A channel of the frame buffer.
+		typedef ::std::vector<float, aligned_allocator<float, 64> > Channel ;
+
+	protected:
+		/// \brief	The width of the image.
+		int m_width ;
+		/// \brief	The height of the image.
+		int m_height ;
+		/// \brief	The size of the tiles.
+		int m_tileSize ;
+		/// \brief	The number of tiles per line of tiles.
+		int m_tilesPerLine ;
+		/// \brief	The sum of the samples (red, green, blue).
+		Channel m_sum[3] ;
+		/// \brief	The number of samples.
+		::std::vector<int, aligned_allocator<int, 64> > m_count ;
+		/// \brief	The mean luminance of the samples.
+		Channel m_mean ;
+		/// \brief	The sum of the squared differences to the mean luminance (Welford).
+		Channel m_squaredDeviation ;
+		/// \brief	Non zero for the pixels that still need samples.
+		::std::vector<char, aligned_allocator<char, 64> > m_active ;
+		/// \brief	Non zero for the pixels whose error is below the target (temporary of
+		/// 		FrameBuffer::updateActivePixels).
+		::std::vector<char, aligned_allocator<char, 64> > m_converged ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int FrameBuffer::index(int x, int y) const
+		///
+		/// \brief	Computes the index of a pixel in the channels.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	The index.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int index(int x, int y) const
+		{
+			int tile = (y/m_tileSize)*m_tilesPerLine+x/m_tileSize ;
+			return (tile*m_tileSize+y%m_tileSize)*m_tileSize+x%m_tileSize ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static float FrameBuffer::luminance(RGBColor const & color)
+		///
+		/// \brief	Computes the luminance of a color.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	color	The color.
+		///
+		/// \return	The luminance.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static float luminance(RGBColor const & color)
+		{
+			return 0.2126f*color[0]+0.7152f*color[1]+0.0722f*color[2] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	FrameBuffer::FrameBuffer(int width=0, int height=0, int tileSize=RENDER_TILE_SIZE)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	width   	The width of the image.
+		/// \param	height  	The height of the image.
+		/// \param	tileSize	The size of the tiles (multiple of 4: a tile is a multiple of 64 bytes).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		FrameBuffer(int width=0, int height=0, int tileSize=RENDER_TILE_SIZE)
+			: m_tileSize(tileSize)
+		{
+			assert(tileSize%4==0) ;
+			resize(width, height) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void FrameBuffer::resize(int width, int height)
+		///
+		/// \brief	Resizes the frame buffer and clears it.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	width 	The width of the image.
+		/// \param	height	The height of the image.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void resize(int width, int height)
+		{
+			m_width = width ;
+			m_height = height ;
+			m_tilesPerLine = (width+m_tileSize-1)/m_tileSize ;
+			int tileLines = (height+m_tileSize-1)/m_tileSize ;
+			size_t size = (size_t)m_tilesPerLine*tileLines*m_tileSize*m_tileSize ;
+			for(int channel=0 ; channel<3 ; ++channel)
+			{
+				m_sum[channel].resize(size) ;
+			}
+			m_count.resize(size) ;
+			m_mean.resize(size) ;
+			m_squaredDeviation.resize(size) ;
+			m_active.resize(size) ;
+			m_converged.resize(size) ;
+			clear() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void FrameBuffer::clear()
+		///
+		/// \brief	Removes all the samples.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void clear()
+		{
+			for(int channel=0 ; channel<3 ; ++channel)
+			{
+				::std::fill(m_sum[channel].begin(), m_sum[channel].end(), 0.0f) ;
+			}
+			::std::fill(m_count.begin(), m_count.end(), 0) ;
+			::std::fill(m_mean.begin(), m_mean.end(), 0.0f) ;
+			::std::fill(m_squaredDeviation.begin(), m_squaredDeviation.end(), 0.0f) ;
+			::std::fill(m_active.begin(), m_active.end(), 1) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int FrameBuffer::width() const
+		///
+		/// \brief	Gets the width of the image.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The width.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int width() const
+		{ return m_width ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int FrameBuffer::height() const
+		///
+		/// \brief	Gets the height of the image.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The height.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int height() const
+		{ return m_height ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void FrameBuffer::add(int x, int y, RGBColor const & sample)
+		///
+		/// \brief	Adds a sample to a pixel.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	  	The column of the pixel.
+		/// \param	y	  	The line of the pixel.
+		/// \param	sample	The sample.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void add(int x, int y, RGBColor const & sample)
+		{
+			int pixel = index(x, y) ;
+			for(int channel=0 ; channel<3 ; ++channel)
+			{
+				m_sum[channel][pixel] += sample[channel] ;
+			}
+			int count = ++m_count[pixel] ;
+			float value = luminance(sample) ;
+			float delta = value-m_mean[pixel] ;
+			m_mean[pixel] += delta/count ;
+			m_squaredDeviation[pixel] += delta*(value-m_mean[pixel]) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void FrameBuffer::copy(FrameBuffer const & source, int x, int y, int width, int height)
+		///
+		/// \brief	Copies the samples of a rectangle of pixels from a frame buffer of the same size.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	source	The copied frame buffer.
+		/// \param	x	  	The column of the first pixel.
+		/// \param	y	  	The line of the first pixel.
+		/// \param	width 	The number of columns.
+		/// \param	height	The number of lines.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void copy(FrameBuffer const & source, int x, int y, int width, int height)
+		{
+			assert(source.m_width==m_width && source.m_height==m_height && source.m_tileSize==m_tileSize) ;
+			for(int line=y ; line<y+height ; ++line)
+			{
+				for(int column=x ; column<x+width ; ++column)
+				{
+					int pixel = index(column, line) ;
+					for(int channel=0 ; channel<3 ; ++channel)
+					{
+						m_sum[channel][pixel] = source.m_sum[channel][pixel] ;
+					}
+					m_count[pixel] = source.m_count[pixel] ;
+					m_mean[pixel] = source.m_mean[pixel] ;
+					m_squaredDeviation[pixel] = source.m_squaredDeviation[pixel] ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor FrameBuffer::color(int x, int y) const
+		///
+		/// \brief	Gets the mean of the samples of a pixel.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	The mean color (black if the pixel has no sample).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor color(int x, int y) const
+		{
+			int pixel = index(x, y) ;
+			if(m_count[pixel]==0) { return RGBColor() ; }
+			return RGBColor(m_sum[0][pixel], m_sum[1][pixel], m_sum[2][pixel])/(float)m_count[pixel] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int FrameBuffer::sampleCount(int x, int y) const
+		///
+		/// \brief	Gets the number of samples of a pixel.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	The number of samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int sampleCount(int x, int y) const
+		{ return m_count[index(x, y)] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float FrameBuffer::variance(int x, int y) const
+		///
+		/// \brief	Gets the variance of the luminance of the samples of a pixel.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	The unbiased sample variance (0 with less than two samples).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float variance(int x, int y) const
+		{
+			int pixel = index(x, y) ;
+			if(m_count[pixel]<2) { return 0.0f ; }
+			return m_squaredDeviation[pixel]/(m_count[pixel]-1) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float FrameBuffer::relativeError(int x, int y) const
+		///
+		/// \brief	Estimates the relative error of the color of a pixel: standard error of the mean
+		/// 		luminance divided by the mean luminance (bounded below by 1e-3, so that black pixels
+		/// 		converge).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	The relative error.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float relativeError(int x, int y) const
+		{
+			int pixel = index(x, y) ;
+			if(m_count[pixel]<2) { return ::std::numeric_limits<float>::max() ; }
+			return sqrt(variance(x, y)/m_count[pixel])/::std::max(m_mean[pixel], 1e-3f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool FrameBuffer::active(int x, int y) const
+		///
+		/// \brief	Tests if a pixel still needs samples.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The column of the pixel.
+		/// \param	y	The line of the pixel.
+		///
+		/// \return	true if the pixel needs samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool active(int x, int y) const
+		{ return m_active[index(x, y)]!=0 ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool FrameBuffer::active(int x, int y, int width, int height) const
+		///
+		/// \brief	Tests if a rectangle of pixels contains a pixel that still needs samples.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	  	The column of the first pixel.
+		/// \param	y	  	The line of the first pixel.
+		/// \param	width 	The number of columns.
+		/// \param	height	The number of lines.
+		///
+		/// \return	true if a pixel of the rectangle needs samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool active(int x, int y, int width, int height) const
+		{
+			for(int line=y ; line<y+height ; ++line)
+			{
+				for(int column=x ; column<x+width ; ++column)
+				{
+					if(active(column, line)) { return true ; }
+				}
+			}
+			return false ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int FrameBuffer::updateActivePixels(float targetError, int minSamples)
+		///
+		/// \brief	Updates the pixels that still need samples: a pixel is converged once it has at least
+		/// 		minSamples samples and a relative error below the target. A pixel stays active while
+		/// 		itself or one of its four neighbours is not converged, so that isolated pixels whose
+		/// 		error is underestimated (edges, rare paths) keep being sampled with their
+		/// 		neighbourhood. Should not be called while samples are added.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	targetError	The target relative error (see FrameBuffer::relativeError).
+		/// \param	minSamples 	The minimum number of samples of a pixel.
+		///
+		/// \return	The number of active pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int updateActivePixels(float targetError, int minSamples)
+		{
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					int pixel = index(x, y) ;
+					m_converged[pixel] = m_count[pixel]>=::std::max(minSamples, 2) && relativeError(x, y)<targetError ;
+				}
+			}
+			int activeCount = 0 ;
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					bool converged = m_converged[index(x, y)] && (x==0 || m_converged[index(x-1, y)]) && (x==m_width-1 || m_converged[index(x+1, y)])
+						&& (y==0 || m_converged[index(x, y-1)]) && (y==m_height-1 || m_converged[index(x, y+1)]) ;
+					m_active[index(x, y)] = !converged ;
+					activeCount += !converged ;
+				}
+			}
+			return activeCount ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int FrameBuffer::limitActivePixels(int maxCount)
+		///
+		/// \brief	Keeps at most maxCount active pixels: the active pixels with the fewest samples, line
+		/// 		by line between pixels with the same number of samples. Used to fit the last pass of
+		/// 		adaptive sampling in the sample budget. Should not be called while samples are added.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	maxCount	The maximum number of active pixels.
+		///
+		/// \return	The number of active pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int limitActivePixels(int maxCount)
+		{
+			::std::vector<int> counts ;
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					int pixel = index(x, y) ;
+					if(m_active[pixel]) { counts.push_back(m_count[pixel]) ; }
+				}
+			}
+			if((int)counts.size()<=maxCount) { return (int)counts.size() ; }
+			// Number of samples of the last kept pixel and number of kept pixels with this number
+			int threshold = -1 ;
+			int thresholdCount = 0 ;
+			if(maxCount>0)
+			{
+				::std::nth_element(counts.begin(), counts.begin()+maxCount-1, counts.end()) ;
+				threshold = counts[maxCount-1] ;
+				thresholdCount = maxCount-(int)::std::count_if(counts.begin(), counts.begin()+maxCount-1, [&](int count) -> bool { return count<threshold ; }) ;
+			}
+			int activeCount = 0 ;
+			for(int y=0 ; y<m_height ; ++y)
+			{
+				for(int x=0 ; x<m_width ; ++x)
+				{
+					int pixel = index(x, y) ;
+					if(!m_active[pixel]) { continue ; }
+					bool keep = m_count[pixel]<threshold || (m_count[pixel]==threshold && thresholdCount-->0) ;
+					m_active[pixel] = keep ;
+					activeCount += keep ;
+				}
+			}
+			return activeCount ;
+		}
+	} ;
+}
+
+#endif
@@ -4,10 +4,17 @@
 #include <Geometry/Triangle.h>
 #include <Geometry/Material.h>
 #include <Math/Vector3.h>
+#include <Math/Transform.h>
 #include <vector>
 #include <deque>
 #include <map>
+#include <algorithm>
+#include <assert.h>
 #include <System/aligned_allocator.h>
+#include <Geometry/Ray.h>
+#include <Geometry/WideBVH.h>
+#include <Geometry/TriangleBlock.h>
+#include <Geometry/RayPacket.h>
 
 namespace Geometry
 {
@@ -26,6 +33,13 @@ namespace Geometry
 	    std::deque<Math::Vector3, aligned_allocator<Math::Vector3, 16> > m_vertices ;
 		/// \brief	The triangles.
 		std::deque<Triangle, aligned_allocator<Triangle, 16> >      m_triangles ;
+		/// \brief	The acceleration structure on the triangles of the geometry (bottom level of the
+		/// 		scene acceleration structure).
+		WideBVH<BVH_WIDTH> m_bvh ;
+		/// \brief	The triangles of the leaves of m_bvh, stored as blocks for SIMD intersection.
+		::std::vector<TriangleBlock<BVH_WIDTH>, aligned_allocator<TriangleBlock<BVH_WIDTH>, BVH_WIDTH*sizeof(float)> > m_blocks ;
+		/// \brief	false if the geometry has been modified since the last build of m_bvh.
+		bool m_bvhUpToDate ;
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	void Geometry::updateTriangles()
@@ -42,6 +56,7 @@ namespace Geometry
 			{
 				m_triangles[cpt].update() ;
 			}
+			m_bvhUpToDate = false ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -60,6 +75,7 @@ namespace Geometry
 		void addTriangle(int i1, int i2, int i3, Material * material)
 		{
 			m_triangles.push_back(Triangle(&m_vertices[i1], &m_vertices[i2], &m_vertices[i3], material)) ; 
+			m_bvhUpToDate = false ;
 		}
 
 	public:
@@ -98,6 +114,7 @@ namespace Geometry
 		/// \date	04/12/2013
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Geometry()
+			: m_bvh(BVH_WIDTH, 1.0f, 1.0f, BVH_WIDTH), m_bvhUpToDate(false)
 		{}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -111,6 +128,7 @@ namespace Geometry
 		/// \param	geom	The geometry.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Geometry(const Geometry & geom)
+			: m_bvh(BVH_WIDTH, 1.0f, 1.0f, BVH_WIDTH), m_bvhUpToDate(false)
 		{
 			merge(geom) ;
 		}
@@ -192,7 +210,6 @@ namespace Geometry
 				auto it = vectorToIndex.find(vertex) ;
 				if(it==vectorToIndex.end())
 				{
-					int index = addVertex(geometry.getVertices()[cpt]) ;
 					vectorToIndex.insert(::std::make_pair(vertex, addVertex(*vertex))) ;
 				}
 			}
@@ -206,6 +223,115 @@ namespace Geometry
 			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Geometry::findTransform(const Geometry & geometry, Math::Transform & transform) const
+		///
+		/// \brief	Tests if the provided geometry is a transformed copy of this one: same triangles (in
+		/// 		the same order) with the same materials, whose vertices are the vertices of this
+		/// 		geometry moved by an affine transform. Used to share the meshes placed several times
+		/// 		in a scene.
+		///
+		/// 		The transform is computed from four vertices of this geometry spanning the space
+		/// 		(chosen far apart for a good conditioning, the normal completes the frame of planar
+		/// 		geometries) and checked on all the vertices, up to the rounding errors of the
+		/// 		transformations applied to the copy.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	geometry		   	The geometry.
+		/// \param [out]	transform	The transform from this geometry to the provided one.
+		///
+		/// \return	true if the provided geometry is a transformed copy of this one.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool findTransform(const Geometry & geometry, Math::Transform & transform) const
+		{
+			if(m_triangles.size()!=geometry.m_triangles.size() || m_triangles.empty()) { return false ; }
+			for(size_t cpt=0 ; cpt<m_triangles.size() ; ++cpt)
+			{
+				if(m_triangles[cpt].material()!=geometry.m_triangles[cpt].material()) { return false ; }
+			}
+			// The vertices are compared through the triangles (index/3: triangle, index%3: vertex)
+			auto point = [](const Geometry & geometry, size_t index) -> const Math::Vector3 &
+			{ return geometry.m_triangles[index/3].vertex(index%3) ; } ;
+			const size_t count = m_triangles.size()*3 ;
+			bool same = true ;
+			for(size_t cpt=0 ; cpt<count && same ; ++cpt)
+			{
+				same = (point(geometry, cpt)-point(*this, cpt)).norm2()==0.0f ;
+			}
+			if(same)
+			{
+				transform = Math::Transform() ;
+				return true ;
+			}
+			// Frame of this geometry
+			const Math::Vector3 & p0 = point(*this, 0) ;
+			size_t i1 = 0, i2 = 0, i3 = 0 ;
+			float best1 = 0.0f, best2 = 0.0f, best3 = 0.0f ;
+			for(size_t cpt=0 ; cpt<count ; ++cpt)
+			{
+				float distance = (point(*this, cpt)-p0).norm2() ;
+				if(distance>best1) { best1 = distance ; i1 = cpt ; }
+			}
+			Math::Vector3 e1 = point(*this, i1)-p0 ;
+			for(size_t cpt=0 ; cpt<count ; ++cpt)
+			{
+				float area = (e1^(point(*this, cpt)-p0)).norm2() ;
+				if(area>best2) { best2 = area ; i2 = cpt ; }
+			}
+			if(best2==0.0f) { return false ; }
+			Math::Vector3 e2 = point(*this, i2)-p0 ;
+			Math::Vector3 n = e1^e2 ;
+			for(size_t cpt=0 ; cpt<count ; ++cpt)
+			{
+				float height = fabs(n*(point(*this, cpt)-p0)) ;
+				if(height>best3) { best3 = height ; i3 = cpt ; }
+			}
+			// Corresponding frame of the copy
+			const Math::Vector3 & q0 = point(geometry, 0) ;
+			Math::Vector3 f1 = point(geometry, i1)-q0 ;
+			Math::Vector3 f2 = point(geometry, i2)-q0 ;
+			Math::Vector3 e3, f3 ;
+			if(best3>1e-4f*n.norm()*e1.norm())
+			{
+				e3 = point(*this, i3)-p0 ;
+				f3 = point(geometry, i3)-q0 ;
+			}
+			else
+			{
+				// Planar geometry: the normal is mapped on the normal of the copy (exact for similarities)
+				Math::Vector3 m = f1^f2 ;
+				if(m.norm2()==0.0f) { return false ; }
+				e3 = n.normalized() ;
+				f3 = m.normalized()*sqrt(m.norm()/n.norm()) ;
+			}
+			// Linear part: columns are the images of the axes, through the inverse of the frame (e1, e2, e3)
+			float determinant = e1*(e2^e3) ;
+			Math::Vector3 rows[3] = { (e2^e3)/determinant, (e3^e1)/determinant, (e1^e2)/determinant } ;
+			Math::Vector3 axis[3] ;
+			for(int cpt=0 ; cpt<3 ; ++cpt)
+			{
+				axis[cpt] = f1*rows[0][cpt]+f2*rows[1][cpt]+f3*rows[2][cpt] ;
+			}
+			Math::Vector3 origin = q0-(axis[0]*p0[0]+axis[1]*p0[1]+axis[2]*p0[2]) ;
+			Math::Transform result(origin, axis[0], axis[1], axis[2]) ;
+			// Flattened copies cannot be instanced (the inverse transform is needed)
+			if(!(fabs(result.determinant())>1e-6f*axis[0].norm()*axis[1].norm()*axis[2].norm())) { return false ; }
+			float size = 0.0f ;
+			for(size_t cpt=0 ; cpt<count ; ++cpt)
+			{
+				size = ::std::max(size, (point(geometry, cpt)-q0).norm2()) ;
+			}
+			float tolerance = 1e-4f*1e-4f*size ;
+			for(size_t cpt=0 ; cpt<count ; ++cpt)
+			{
+				if((result.toWorld(point(*this, cpt))-point(geometry, cpt)).norm2()>tolerance) { return false ; }
+			}
+			transform = result ;
+			return true ;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	bool Geometry::intersection(CastedRay & ray)
 		///
@@ -231,6 +357,162 @@ namespace Geometry
 			return ray.validIntersectionFound() ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Geometry::buildAccelerationStructure()
+		///
+		/// \brief	Builds the bounding volume hierarchy on the triangles of this geometry, the triangles of
+		/// 		each leaf are copied in triangle blocks. The structure is only valid until the next
+		/// 		modification of the geometry (see Geometry::accelerationStructureUpToDate).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void buildAccelerationStructure()
+		{
+			::std::vector<BoundingBox, aligned_allocator<BoundingBox, 16> > boxes ;
+			boxes.reserve(m_triangles.size()) ;
+			for(auto it=m_triangles.begin(), end=m_triangles.end() ; it!=end ; ++it)
+			{
+				BoundingBox box ;
+				box.update(*it) ;
+				boxes.push_back(box) ;
+			}
+			m_bvh.build(boxes) ;
+
+			m_blocks.clear() ;
+			const ::std::vector<int> & primitives = m_bvh.getPrimitives() ;
+			auto mapper = [&](int first, int count) -> int
+			{
+				int firstBlock = (int)m_blocks.size() ;
+				for(int cpt=0 ; cpt<count ; ++cpt)
+				{
+					if(cpt%BVH_WIDTH==0) { m_blocks.push_back(TriangleBlock<BVH_WIDTH>()) ; }
+					int index = primitives[first+cpt] ;
+					m_blocks.back().set(cpt%BVH_WIDTH, m_triangles[index], index) ;
+				}
+				return firstBlock ;
+			} ;
+			m_bvh.mapLeaves(mapper) ;
+			m_bvhUpToDate = true ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Geometry::accelerationStructureUpToDate() const
+		///
+		/// \brief	Tells if the acceleration structure reflects the current state of the geometry. 
+		/// 		Adding triangles or applying a transformation invalidates it.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if the acceleration structure does not need to be rebuilt.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool accelerationStructureUpToDate() const
+		{ return m_bvhUpToDate ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Geometry::intersection(Ray const & ray, float & tMax, const Triangle * & triangle,
+		/// 	float & u, float & v,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(),
+		/// 	float tMin=0.0001f) const
+		///
+		/// \brief	Computes the nearest intersection between this geometry and the ray, closer than tMax,
+		/// 		with the acceleration structure (which should be up to date).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray					The ray.
+		/// \param [in,out]	tMax		The maximum distance, updated with the distance of the nearest
+		/// 							intersection.
+		/// \param [out]	triangle	The nearest intersected triangle.
+		/// \param [out]	u			The u coordinate of the intersection.
+		/// \param [out]	v			The v coordinate of the intersection.
+		/// \param	instructionSet		The instruction set of the kernels.
+		/// \param	tMin				The minimal distance of the intersections.
+		///
+		/// \return	true if an intersection closer than tMax has been found.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool intersection(Ray const & ray, float & tMax, const Triangle * & triangle, float & u, float & v, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(), float tMin=0.0001f) const
+		{
+			assert(m_bvhUpToDate) ;
+			TriangleBlockTest<BVH_WIDTH> blockTest(ray, instructionSet, tMin) ;
+			auto intersector = [&](int firstBlock, int count, float & tCurrent) -> bool
+			{
+				bool found = false ;
+				for(int block=firstBlock, end=firstBlock+(count+BVH_WIDTH-1)/BVH_WIDTH ; block<end ; ++block)
+				{
+					int index = blockTest.intersect(m_blocks[block], tCurrent, u, v) ;
+					if(index>=0)
+					{
+						triangle = &m_triangles[index] ;
+						found = true ;
+					}
+				}
+				return found ;
+			} ;
+			return m_bvh.intersectLeaves(ray, tMax, intersector, instructionSet) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <int Size> void Geometry::intersection(RayPacket<Size> & packet) const
+		///
+		/// \brief	Updates the nearest intersections of a coherent packet of rays with the triangles of
+		/// 		this geometry (the acceleration structure should be up to date).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param [in,out]	packet	The packet.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <int Size>
+		void intersection(RayPacket<Size> & packet) const
+		{
+			assert(m_bvhUpToDate) ;
+			auto intersector = [&](int firstBlock, int count, RayPacket<Size> & current)
+			{
+				for(int block=firstBlock, end=firstBlock+(count+BVH_WIDTH-1)/BVH_WIDTH ; block<end ; ++block)
+				{
+					current.intersect(m_blocks[block], m_triangles) ;
+				}
+			} ;
+			m_bvh.intersectLeaves(packet, intersector) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Geometry::occluded(Ray const & ray, float tMax,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(),
+		/// 	float tMin=0.0001f) const
+		///
+		/// \brief	Tests if a triangle of this geometry intersects the ray nearer than tMax. Stops at the
+		/// 		first intersection found (the acceleration structure should be up to date).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray 	The ray.
+		/// \param	tMax			The maximum distance on the ray.
+		/// \param	instructionSet	The instruction set of the kernels.
+		/// \param	tMin			The minimal distance of the intersections.
+		///
+		/// \return	true if the ray is blocked by this geometry before tMax.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool occluded(Ray const & ray, float tMax, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(), float tMin=0.0001f) const
+		{
+			assert(m_bvhUpToDate) ;
+			TriangleBlockTest<BVH_WIDTH> blockTest(ray, instructionSet, tMin) ;
+			auto intersector = [&](int firstBlock, int count, float & tCurrent) -> bool
+			{
+				float u, v ;
+				for(int block=firstBlock, end=firstBlock+(count+BVH_WIDTH-1)/BVH_WIDTH ; block<end ; ++block)
+				{
+					if(blockTest.intersect(m_blocks[block], tCurrent, u, v)>=0) { return true ; }
+				}
+				return false ;
+			} ;
+			return m_bvh.occludedLeaves(ray, tMax, intersector, instructionSet) ;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	void Geometry::translate(Math::Vector3 const & t)
 		///
@@ -247,6 +529,7 @@ namespace Geometry
 			{
 				(*it) = (*it)+t ; 
 			}
+			updateTriangles() ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -343,8 +626,53 @@ namespace Geometry
 			}
 			updateTriangles() ;
 		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Geometry::transform(Math::Transform const & transform)
+		///
+		/// \brief	Applies an affine transform on this geometry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	transform	The transform.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void transform(Math::Transform const & transform)
+		{
+			for(auto it=m_vertices.begin(), end=m_vertices.end() ; it!=end ; ++it)
+			{
+				(*it) = transform.toWorld(*it) ;
+			}
+			updateTriangles() ;
+		}
 	} ;
 
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// BoundingBox methods depending on Geometry (declared in Geometry/BoundingBox.h).
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BoundingBox::BoundingBox(Geometry const & geometry)
+	{
+		set(geometry);
+	}
+
+	void BoundingBox::set( Geometry const &geometry ) 
+	{
+		const std::deque<Math::Vector3, aligned_allocator<Math::Vector3, 16> > & vertices(geometry.getVertices()) ;
+		m_bounds[0] = vertices[0] ;
+		m_bounds[1] = vertices[0] ;
+		update(geometry) ;
+	}
+
+	void BoundingBox::update(Geometry const & geometry)
+	{
+		const std::deque<Math::Vector3, aligned_allocator<Math::Vector3, 16> > & vertices(geometry.getVertices()) ;
+		for(auto it=vertices.begin(), end=vertices.end() ; it!=end ; ++it)
+		{
+			m_bounds[0] = m_bounds[0].simdMin(*it) ;
+			m_bounds[1] = m_bounds[1].simdMax(*it) ;
+		}
+	}
 }
 
 
@@ -0,0 +1,240 @@
+#ifndef _Geometry_Instance_H
+#define _Geometry_Instance_H
+
+#include <limits>
+#include <Math/Vector3.h>
+#include <Math/Transform.h>
+#include <Geometry/Ray.h>
+#include <Geometry/BoundingBox.h>
+#include <Geometry/Geometry.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Instance
+	///
+	/// \brief	A placement of a shared mesh in the scene: the mesh (with its acceleration structure) is
+	/// 		stored once in its own frame, each instance only holds an affine transform and its
+	/// 		bounding box in world space.
+	///
+	/// 		The rays are transformed in the frame of the mesh during the traversal. The direction
+	/// 		of the transformed ray is normalized by Ray, the distances along the ray are converted
+	/// 		by the norm of the transformed direction. The instances placed by the identity
+	/// 		transform use the rays of the scene directly.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Instance
+	{
+	protected:
+		/// \brief	The transform from the frame of the mesh to world space.
+		Math::Transform m_transform ;
+		/// \brief	The bounding box of the instance (in world space).
+		BoundingBox m_boundingBox ;
+		/// \brief	The shared mesh.
+		const Geometry * m_geometry ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Ray Instance::localRay(Ray const & ray, float & scale) const
+		///
+		/// \brief	Transforms a ray in the frame of the mesh.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray				 	The ray (in world space).
+		/// \param [out]	scale	The distance along the transformed ray for a unit distance along
+		/// 						the provided ray.
+		///
+		/// \return	The ray in the frame of the mesh.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Ray localRay(Ray const & ray, float & scale) const
+		{
+			Math::Vector3 direction = m_transform.directionToLocal(ray.direction()) ;
+			scale = direction.norm() ;
+			return Ray(m_transform.toLocal(ray.source()), direction) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static float Instance::localDistance(float t, float scale)
+		///
+		/// \brief	Converts a distance along a ray in the frame of the mesh (the unbounded distance is
+		/// 		kept as is).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	t	 	The distance along the ray (in world space).
+		/// \param	scale	The scale computed by localRay.
+		///
+		/// \return	The distance along the transformed ray.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static float localDistance(float t, float scale)
+		{
+			if(t>=::std::numeric_limits<float>::max()/scale) { return ::std::numeric_limits<float>::max() ; }
+			return t*scale ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Instance::Instance(const Geometry * geometry, Math::Transform const & transform)
+		///
+		/// \brief	Constructor. The bounding box is computed by update.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	geometry 	The shared mesh.
+		/// \param	transform	The transform from the frame of the mesh to world space.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Instance(const Geometry * geometry, Math::Transform const & transform)
+			: m_transform(transform), m_geometry(geometry)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Geometry * Instance::geometry() const
+		///
+		/// \brief	Gets the shared mesh.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The mesh.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Geometry * geometry() const
+		{ return m_geometry ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Transform const & Instance::transform() const
+		///
+		/// \brief	Gets the transform from the frame of the mesh to world space.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The transform.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Transform const & transform() const
+		{ return m_transform ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Math::Transform * Instance::objectTransform() const
+		///
+		/// \brief	Gets the transform associated with the intersections of this instance (see
+		/// 		RayTriangleIntersection::transform).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The transform, NULL if the mesh is in world space.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Math::Transform * objectTransform() const
+		{ return m_transform.identity() ? NULL : &m_transform ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	BoundingBox const & Instance::boundingBox() const
+		///
+		/// \brief	Gets the bounding box of the instance.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The bounding box (in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		BoundingBox const & boundingBox() const
+		{ return m_boundingBox ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Instance::update(BoundingBox const & geometryBox)
+		///
+		/// \brief	Updates the bounding box of the instance (the box of the transformed corners of the
+		/// 		bounding box of the mesh).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	geometryBox	The bounding box of the mesh (in the frame of the mesh).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void update(BoundingBox const & geometryBox)
+		{
+			if(m_transform.identity())
+			{
+				m_boundingBox = geometryBox ;
+				return ;
+			}
+			m_boundingBox = BoundingBox() ;
+			const Math::Vector3 & minVertex = geometryBox.minVertex() ;
+			const Math::Vector3 & maxVertex = geometryBox.maxVertex() ;
+			for(int corner=0 ; corner<8 ; ++corner)
+			{
+				Math::Vector3 point((corner&1) ? maxVertex[0] : minVertex[0], (corner&2) ? maxVertex[1] : minVertex[1], (corner&4) ? maxVertex[2] : minVertex[2]) ;
+				m_boundingBox.update(m_transform.toWorld(point)) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Instance::intersection(Ray const & ray, float & tMax, const Triangle * & triangle,
+		/// 	float & u, float & v,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(),
+		/// 	float tMin=0.0001f) const
+		///
+		/// \brief	Computes the nearest intersection between a ray and the instance (see
+		/// 		Geometry::intersection). Both bounds of the distance are converted in the frame of the
+		/// 		mesh, so that the self intersection threshold does not depend on the scale of the
+		/// 		instance.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray						The ray (in world space).
+		/// \param [in,out]	tMax		The maximum distance on the ray, replaced by the distance of the
+		/// 							intersection (in world space).
+		/// \param [out]	triangle	The nearest intersected triangle (of the shared mesh).
+		/// \param [out]	u			The u coordinate of the intersection.
+		/// \param [out]	v			The v coordinate of the intersection.
+		/// \param	instructionSet		The instruction set of the kernels.
+		/// \param	tMin				The minimal distance of the intersections (in world space).
+		///
+		/// \return	true if an intersection closer than tMax has been found.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool intersection(Ray const & ray, float & tMax, const Triangle * & triangle, float & u, float & v, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(), float tMin=0.0001f) const
+		{
+			if(m_transform.identity()) { return m_geometry->intersection(ray, tMax, triangle, u, v, instructionSet, tMin) ; }
+			float scale ;
+			Ray local = localRay(ray, scale) ;
+			float t = localDistance(tMax, scale) ;
+			if(!m_geometry->intersection(local, t, triangle, u, v, instructionSet, localDistance(tMin, scale))) { return false ; }
+			tMax = t/scale ;
+			return true ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Instance::occluded(Ray const & ray, float tMax,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(),
+		/// 	float tMin=0.0001f) const
+		///
+		/// \brief	Tests if the instance intersects the ray nearer than tMax (see Geometry::occluded),
+		/// 		the bounds of the distance being converted as in Instance::intersection.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray 	The ray (in world space).
+		/// \param	tMax			The maximum distance on the ray.
+		/// \param	instructionSet	The instruction set of the kernels.
+		/// \param	tMin			The minimal distance of the intersections (in world space).
+		///
+		/// \return	true if the ray is blocked by the instance before tMax.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool occluded(Ray const & ray, float tMax, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet(), float tMin=0.0001f) const
+		{
+			if(m_transform.identity()) { return m_geometry->occluded(ray, tMax, instructionSet, tMin) ; }
+			float scale ;
+			Ray local = localRay(ray, scale) ;
+			return m_geometry->occluded(local, localDistance(tMax, scale), instructionSet, localDistance(tMin, scale)) ;
+		}
+	} ;
+}
+
+#endif
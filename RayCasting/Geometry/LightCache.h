@@ -1,67 +1,360 @@
 #ifndef _Geometry_LightCache_H
 #define _Geometry_LightCache_H
 
+#include <vector>
+#include <algorithm>
+#include <math.h>
 #include <Geometry/RGBColor.h>
+#include <Geometry/BoundingBox.h>
+#include <Math/Vector3.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Geometry
 {
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	LightCache
+	///
+	/// \brief	Irradiance cache (G. Ward, "A Ray Tracing Solution for Diffuse Interreflection", 1988).
+	/// 		A record stores the indirect diffuse lighting computed at a point, with the harmonic
+	/// 		mean distance to the surfaces seen from this point. A record is reused at a point P of
+	/// 		normal N if its error bound
+	/// 		\f$\epsilon_i = \|P-P_i\|/R_i + \sqrt{1-N.N_i}\f$ is below the accuracy, the cached
+	/// 		values being interpolated with the weights \f$1/\epsilon_i\f$.
+	///
+	/// 		Records are stored in a hashed uniform grid covering the scene: a record is inserted in
+	/// 		every cell overlapped by its sphere of influence (of radius accuracy.R_i, bounded by the
+	/// 		half size of a cell), so that a lookup only visits the cell of the point. Each bucket of
+	/// 		the grid has its own lock: lookups and insertions can be done concurrently by the
+	/// 		rendering threads. Records are kept until LightCache::clear is called. A record holds a
+	/// 		single estimate that is never refined: the scene clears the cache at the beginning of
+	/// 		each rendering pass, so that the noise of the records is averaged by the passes
+	/// 		instead of being repeated by all of them.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
 	class LightCache
 	{
 	public:
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \typedef	::std::pair<int, int> Coordinates
+		/// \struct	Record
 		///
-		/// \brief	Defines an alias representing the coordinates (x,y).
+		/// \brief	A record of the cache.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		typedef ::std::pair<int, int> Coordinates ;
+		struct Record
+		{
+			/// \brief	The position.
+			Math::Vector3 m_position ;
+			/// \brief	The normal of the surface.
+			Math::Vector3 m_normal ;
+			/// \brief	The mean radiance incoming on the surface (cosine weighted).
+			RGBColor m_irradiance ;
+			/// \brief	The harmonic mean distance to the surfaces seen from the position (bounded).
+			float m_radius ;
+			/// \brief	The depth of the computation (the record is valid for this depth and the
+			/// 		following ones).
+			int m_depth ;
+		} ;
+
+		/// \brief	The number of buckets of the hashed grid (power of two).
+		static const int bucketCount = 4096 ;
+
+		/// \brief	The number of cells along the largest side of the scene.
+		static const int gridResolution = 64 ;
 
+	protected:
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \typedef	::std::pair<RGBColor, int> TexelRecord
+		/// \struct	Bucket
 		///
-		/// \brief	Defines an alias representing the texel record (color, depth of computation).
+		/// \brief	A bucket of the hashed grid.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		typedef ::std::pair<RGBColor, int> TexelRecord ;
+		struct Bucket
+		{
+#ifdef _OPENMP
+			/// \brief	Protects the records of the bucket.
+			omp_lock_t m_lock ;
+#endif
+			/// \brief	The records whose sphere of influence overlaps a cell of the bucket.
+			::std::vector<Record> m_records ;
+		} ;
+
+		/// \brief	The buckets of the hashed grid.
+		::std::vector<Bucket> m_buckets ;
+		/// \brief	The origin of the grid.
+		Math::Vector3 m_origin ;
+		/// \brief	The size of the cells of the grid.
+		float m_cellSize ;
+		/// \brief	The accuracy (maximum error of the interpolated records).
+		float m_accuracy ;
+		/// \brief	The number of records.
+		int m_size ;
+#ifdef _OPENMP
+		/// \brief	Protects the number of records.
+		omp_lock_t m_sizeLock ;
+#endif
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \typedef	::std::map<Coordinates, TexelRecord> TriangleCache
+		/// \fn	void LightCache::cell(Math::Vector3 const & position, int * coordinates) const
+		///
+		/// \brief	Computes the coordinates of the cell containing a point.
 		///
-		/// \brief	Defines an alias representing the triangle cache i.e. the association between local 
-		/// 		triangle coordinates and the texel record.
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	position		   	The point.
+		/// \param [out]	coordinates	The coordinates of the cell.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		typedef ::std::map<Coordinates, TexelRecord> TriangleCache ;
+		void cell(Math::Vector3 const & position, int * coordinates) const
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				coordinates[axis] = (int)floor((position[axis]-m_origin[axis])/m_cellSize) ;
+			}
+		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \typedef	::std::map<const Triangle *, TriangleCache> Cache
+		/// \fn	static int LightCache::bucket(int x, int y, int z)
+		///
+		/// \brief	Computes the bucket of a cell.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
 		///
-		/// \brief	Defines an alias representing the light cache i.e. association between triangle and
-		/// 		triangle cache.
+		/// \param	x	The x coordinate of the cell.
+		/// \param	y	The y coordinate of the cell.
+		/// \param	z	The z coordinate of the cell.
+		///
+		/// \return	The index of the bucket.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		typedef ::std::map<const Triangle *, TriangleCache> Cache ;
-
-	protected:
-		/// \brief	The cache.
-		Cache m_cache ;
+		static int bucket(int x, int y, int z)
+		{
+			unsigned int hash = ((unsigned int)x*73856093U) ^ ((unsigned int)y*19349663U) ^ ((unsigned int)z*83492791U) ;
+			return (int)(hash&(bucketCount-1)) ;
+		}
 
 	public:
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	LightCache::LightCache()
+		/// \fn	LightCache::LightCache(float accuracy=0.2f)
 		///
-		/// \brief	Default constructor.
+		/// \brief	Constructor.
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	07/12/2013
+		///
+		/// \param	accuracy	The accuracy (Ward's a parameter, 0.1 to 0.3 are usual values).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		LightCache(float accuracy=0.2f)
+			: m_buckets(bucketCount), m_origin(0.0f, 0.0f, 0.0f), m_cellSize(1.0f), m_accuracy(accuracy), m_size(0)
+		{
+#ifdef _OPENMP
+			for(int cpt=0 ; cpt<bucketCount ; ++cpt)
+			{
+				omp_init_lock(&m_buckets[cpt].m_lock) ;
+			}
+			omp_init_lock(&m_sizeLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	LightCache::~LightCache()
+		///
+		/// \brief	Destructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		~LightCache()
+		{
+#ifdef _OPENMP
+			for(int cpt=0 ; cpt<bucketCount ; ++cpt)
+			{
+				omp_destroy_lock(&m_buckets[cpt].m_lock) ;
+			}
+			omp_destroy_lock(&m_sizeLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LightCache::reset(BoundingBox const & box)
+		///
+		/// \brief	Removes all the records and adapts the grid to the extent of the scene. Should be
+		/// 		called each time the scene is modified.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	box	The bounding box of the scene.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void reset(BoundingBox const & box)
+		{
+			clear() ;
+			if(box.isEmpty()) { return ; }
+			Math::Vector3 diagonal = box.maxVertex()-box.minVertex() ;
+			float side = ::std::max(diagonal[0], ::std::max(diagonal[1], diagonal[2])) ;
+			m_origin = box.minVertex() ;
+			m_cellSize = ::std::max(side, 1e-6f)/gridResolution ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LightCache::clear()
+		///
+		/// \brief	Removes all the records, the grid is kept. Must not be called during lookups or
+		/// 		insertions.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		LightCache()
-		{}
+		void clear()
+		{
+			for(int cpt=0 ; cpt<bucketCount ; ++cpt)
+			{
+				m_buckets[cpt].m_records.clear() ;
+			}
+			m_size = 0 ;
+		}
 
-		TriangleCache & getTriangleCache(const Triangle * triangle)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LightCache::setAccuracy(float accuracy)
+		///
+		/// \brief	Sets the accuracy. Lower values give more records and smaller interpolation errors.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	accuracy	The accuracy.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setAccuracy(float accuracy)
 		{
-			return m_cache[triangle] ;
+			m_accuracy = accuracy ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int LightCache::size() const
+		///
+		/// \brief	Gets the number of records.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The number of records.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int size() const
+		{
+			return m_size ;
+		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool LightCache::lookup(Math::Vector3 const & position, Math::Vector3 const & normal,
+		/// 	int depth, RGBColor & irradiance)
+		///
+		/// \brief	Interpolates the records that are valid at a point.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	position		  	The point.
+		/// \param	normal			  	The normal of the surface (oriented toward the viewer).
+		/// \param	depth			  	The depth of the computation.
+		/// \param [out]	irradiance	The interpolated mean incoming radiance.
+		///
+		/// \return	false if no record is valid at the point.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool lookup(Math::Vector3 const & position, Math::Vector3 const & normal, int depth, RGBColor & irradiance)
+		{
+			int coordinates[3] ;
+			cell(position, coordinates) ;
+			Bucket & bucket = m_buckets[LightCache::bucket(coordinates[0], coordinates[1], coordinates[2])] ;
+			const float maxWeight = 1e6f ;
+			float totalWeight = 0.0f ;
+			RGBColor sum ;
+#ifdef _OPENMP
+			omp_set_lock(&bucket.m_lock) ;
+#endif
+			for(auto it=bucket.m_records.begin(), end=bucket.m_records.end() ; it!=end ; ++it)
+			{
+				if(it->m_depth>depth) { continue ; }
+				Math::Vector3 offset = position-it->m_position ;
+				float distance = offset.norm() ;
+				if(distance>=m_accuracy*it->m_radius) { continue ; }
+				// The record is in front of the point: it does not see the same surfaces
+				if(offset*(normal+it->m_normal)<-0.1f*distance) { continue ; }
+				float error = distance/it->m_radius+sqrt(::std::max(0.0f, 1.0f-normal*it->m_normal)) ;
+				if(error>=m_accuracy) { continue ; }
+				float weight = ::std::min(1.0f/error, maxWeight) ;
+				sum = sum+it->m_irradiance*weight ;
+				totalWeight += weight ;
+			}
+#ifdef _OPENMP
+			omp_unset_lock(&bucket.m_lock) ;
+#endif
+			if(totalWeight==0.0f) { return false ; }
+			irradiance = sum/totalWeight ;
+			return true ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void LightCache::insert(Math::Vector3 const & position, Math::Vector3 const & normal,
+		/// 	int depth, RGBColor const & irradiance, float harmonicDistance)
+		///
+		/// \brief	Inserts a record.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	position			The point.
+		/// \param	normal				The normal of the surface (oriented toward the viewer).
+		/// \param	depth				The depth of the computation.
+		/// \param	irradiance			The mean incoming radiance.
+		/// \param	harmonicDistance	The harmonic mean distance to the surfaces seen from the point.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void insert(Math::Vector3 const & position, Math::Vector3 const & normal, int depth, RGBColor const & irradiance, float harmonicDistance)
+		{
+			// The influence of a record is bounded by the half size of a cell: it overlaps at most 8 cells
+			float maxRadius = 0.5f*m_cellSize/m_accuracy ;
+			Record record ;
+			record.m_position = position ;
+			record.m_normal = normal ;
+			record.m_irradiance = irradiance ;
+			record.m_radius = ::std::max(::std::min(harmonicDistance, maxRadius), maxRadius/64.0f) ;
+			record.m_depth = depth ;
+			float influence = m_accuracy*record.m_radius ;
+			int low[3], high[3] ;
+			cell(position-Math::Vector3(influence, influence, influence), low) ;
+			cell(position+Math::Vector3(influence, influence, influence), high) ;
+			int inserted[27] ;
+			int insertedCount = 0 ;
+			for(int x=low[0] ; x<=high[0] ; ++x)
+			{
+				for(int y=low[1] ; y<=high[1] ; ++y)
+				{
+					for(int z=low[2] ; z<=high[2] ; ++z)
+					{
+						int index = bucket(x, y, z) ;
+						// Two cells may share a bucket
+						if(::std::find(inserted, inserted+insertedCount, index)!=inserted+insertedCount) { continue ; }
+						inserted[insertedCount++] = index ;
+#ifdef _OPENMP
+						omp_set_lock(&m_buckets[index].m_lock) ;
+#endif
+						m_buckets[index].m_records.push_back(record) ;
+#ifdef _OPENMP
+						omp_unset_lock(&m_buckets[index].m_lock) ;
+#endif
+					}
+				}
+			}
+#ifdef _OPENMP
+			omp_set_lock(&m_sizeLock) ;
+#endif
+			++m_size ;
+#ifdef _OPENMP
+			omp_unset_lock(&m_sizeLock) ;
+#endif
+		}
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,517 @@
+#ifndef _Geometry_Quadric_H
+#define _Geometry_Quadric_H
+
+#include <math.h>
+#include <algorithm>
+#include <Math/Vector3.h>
+#include <Math/Quaternion.h>
+#include <Math/Transform.h>
+#include <Geometry/Ray.h>
+#include <Geometry/Material.h>
+#include <Geometry/BoundingBox.h>
+#include <Geometry/RayTriangleIntersection.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Quadric
+	///
+	/// \brief	An analytic primitive (sphere, cylinder, cone or disk) intersected in closed form
+	/// 		instead of being tessellated. The primitive is a canonical shape in its local frame,
+	/// 		with the dimensions of the corresponding tessellated geometry:
+	/// 		- sphere: centered in (0,0,0), 0.5 radius (see Sphere),
+	/// 		- cylinder: axis Z, 1.0 radius, from z=-0.5 to z=0.5, closed by two disks (see Cylinder),
+	/// 		- cone: axis Z, 1.0 base radius at z=-0.5, apex at z=0.5, closed by its base (see Cone),
+	/// 		- disk: on (X,Y) plane, centered in (0,0,0), 1.0 radius (see Disk).
+	/// 		The local frame is placed in the scene by an affine transform, modified with the same
+	/// 		methods as Geometry (non uniform scales turn spheres into ellipsoids). The transform
+	/// 		and its inverse are stored, the rays are transformed in the local frame (the distance
+	/// 		along the ray is preserved by the transform).
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Quadric
+	{
+	public:
+		/// \brief	The canonical shapes.
+		enum Type { sphere, cylinder, cone, disk } ;
+
+	protected:
+		/// \brief	The shape.
+		Type m_type ;
+		/// \brief	The transform of the local frame (local to world).
+		Math::Transform m_transform ;
+		/// \brief	The bounding box of the primitive (in world space).
+		BoundingBox m_boundingBox ;
+		/// \brief	The associated material.
+		Material * m_material ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::update()
+		///
+		/// \brief	Updates the bounding box. Called after each modification of the transform.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void update()
+		{
+			const Math::Vector3 & origin = m_transform.origin() ;
+			m_boundingBox = BoundingBox() ;
+			switch(m_type)
+			{
+			case sphere:
+				{
+					// Exact bounds of the ellipsoid: 0.5 times the norms of the rows of the transform
+					const Math::Vector3 & x = m_transform.axis(0) ;
+					const Math::Vector3 & y = m_transform.axis(1) ;
+					const Math::Vector3 & z = m_transform.axis(2) ;
+					Math::Vector3 extent ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						extent[axis] = 0.5f*sqrt(x[axis]*x[axis]+y[axis]*y[axis]+z[axis]*z[axis]) ;
+					}
+					m_boundingBox.update(origin-extent) ;
+					m_boundingBox.update(origin+extent) ;
+				}
+				break ;
+			case cylinder:
+				m_boundingBox.update(diskBoundingBox(-0.5f)) ;
+				m_boundingBox.update(diskBoundingBox(0.5f)) ;
+				break ;
+			case cone:
+				m_boundingBox.update(diskBoundingBox(-0.5f)) ;
+				m_boundingBox.update(origin+m_transform.axis(2)*0.5f) ;
+				break ;
+			case disk:
+				m_boundingBox.update(diskBoundingBox(0.0f)) ;
+				break ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	BoundingBox Quadric::diskBoundingBox(float z) const
+		///
+		/// \brief	Computes the exact bounding box of the unit radius disk of the local (X,Y) plane at
+		/// 		a given height, in world space.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	z	The height of the disk in the local frame.
+		///
+		/// \return	The bounding box.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		BoundingBox diskBoundingBox(float z) const
+		{
+			const Math::Vector3 & x = m_transform.axis(0) ;
+			const Math::Vector3 & y = m_transform.axis(1) ;
+			Math::Vector3 center = m_transform.origin()+m_transform.axis(2)*z ;
+			Math::Vector3 extent ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				extent[axis] = sqrt(x[axis]*x[axis]+y[axis]*y[axis]) ;
+			}
+			return BoundingBox(center-extent, center+extent) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static int Quadric::solve(float a, float b, float c, float roots[2])
+		///
+		/// \brief	Solves a.t^2 + 2b.t + c = 0 (the reduced discriminant avoids the cancellation of the
+		/// 		textbook formula for the root of smallest magnitude).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	a			 	The coefficient of t^2.
+		/// \param	b			 	Half the coefficient of t.
+		/// \param	c			 	The constant coefficient.
+		/// \param [out]	roots	The roots.
+		///
+		/// \return	The number of roots.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static int solve(float a, float b, float c, float roots[2])
+		{
+			if(a==0.0f)
+			{
+				if(b==0.0f) { return 0 ; }
+				roots[0] = -c/(2.0f*b) ;
+				return 1 ;
+			}
+			float discriminant = b*b-a*c ;
+			if(discriminant<0.0f) { return 0 ; }
+			float q = b<0.0f ? sqrt(discriminant)-b : -b-sqrt(discriminant) ;
+			roots[0] = q/a ;
+			roots[1] = q!=0.0f ? c/q : roots[0] ;
+			return 2 ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Quadric::nearest(Ray const & ray, float tMax, float & t) const
+		///
+		/// \brief	Computes the nearest intersection between a ray and this primitive, nearer than a
+		/// 		given distance.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray		 	The ray.
+		/// \param	tMax	 	The maximum distance on the ray.
+		/// \param [out]	t	The distance of the intersection, if any.
+		///
+		/// \return	true if an intersection nearer than tMax has been found.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool nearest(Ray const & ray, float tMax, float & t) const
+		{
+			// Same self intersection threshold as the triangles
+			const float tMin = 0.0001f ;
+			Math::Vector3 source = m_transform.toLocal(ray.source()) ;
+			Math::Vector3 direction = m_transform.directionToLocal(ray.direction()) ;
+			float o[3], d[3] ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				o[axis] = source[axis] ;
+				d[axis] = direction[axis] ;
+			}
+			t = tMax ;
+			bool found = false ;
+			float roots[2] ;
+			int count ;
+			switch(m_type)
+			{
+			case sphere:
+				count = solve(d[0]*d[0]+d[1]*d[1]+d[2]*d[2], o[0]*d[0]+o[1]*d[1]+o[2]*d[2], o[0]*o[0]+o[1]*o[1]+o[2]*o[2]-0.25f, roots) ;
+				for(int cpt=0 ; cpt<count ; ++cpt)
+				{
+					if(roots[cpt]>=tMin && roots[cpt]<t) { t = roots[cpt] ; found = true ; }
+				}
+				break ;
+			case cylinder:
+				count = solve(d[0]*d[0]+d[1]*d[1], o[0]*d[0]+o[1]*d[1], o[0]*o[0]+o[1]*o[1]-1.0f, roots) ;
+				for(int cpt=0 ; cpt<count ; ++cpt)
+				{
+					if(roots[cpt]>=tMin && roots[cpt]<t && fabs(o[2]+roots[cpt]*d[2])<=0.5f) { t = roots[cpt] ; found = true ; }
+				}
+				found = capIntersection(o, d, -0.5f, tMin, t) | found ;
+				found = capIntersection(o, d, 0.5f, tMin, t) | found ;
+				break ;
+			case cone:
+				{
+					// x^2 + y^2 = w^2 with w = 0.5 - z, the distance to the apex along the axis
+					float w = 0.5f-o[2] ;
+					count = solve(d[0]*d[0]+d[1]*d[1]-d[2]*d[2], o[0]*d[0]+o[1]*d[1]+w*d[2], o[0]*o[0]+o[1]*o[1]-w*w, roots) ;
+					for(int cpt=0 ; cpt<count ; ++cpt)
+					{
+						float z = o[2]+roots[cpt]*d[2] ;
+						if(roots[cpt]>=tMin && roots[cpt]<t && z>=-0.5f && z<=0.5f) { t = roots[cpt] ; found = true ; }
+					}
+					found = capIntersection(o, d, -0.5f, tMin, t) | found ;
+				}
+				break ;
+			case disk:
+				found = capIntersection(o, d, 0.0f, tMin, t) ;
+				break ;
+			}
+			return found ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static bool Quadric::capIntersection(const float o[3], const float d[3], float z,
+		/// 	float tMin, float & t)
+		///
+		/// \brief	Intersection between a ray (in the local frame) and the unit radius disk of the
+		/// 		(X,Y) plane at a given height.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	o		   	The source of the ray in the local frame.
+		/// \param	d		   	The direction of the ray in the local frame.
+		/// \param	z		   	The height of the disk.
+		/// \param	tMin	   	The minimum distance on the ray.
+		/// \param [in,out]	t	The maximum distance on the ray, replaced by the distance of the
+		/// 					intersection if any.
+		///
+		/// \return	true if the disk is intersected between tMin and t.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static bool capIntersection(const float o[3], const float d[3], float z, float tMin, float & t)
+		{
+			if(d[2]==0.0f) { return false ; }
+			float tPlane = (z-o[2])/d[2] ;
+			if(!(tPlane>=tMin && tPlane<t)) { return false ; }
+			float x = o[0]+tPlane*d[0] ;
+			float y = o[1]+tPlane*d[1] ;
+			if(x*x+y*y>1.0f) { return false ; }
+			t = tPlane ;
+			return true ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Quadric::Quadric(Type type, Material * material)
+		///
+		/// \brief	Constructor of a canonical primitive (identity transform).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	type				The shape.
+		/// \param [in,out]	material	The material.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Quadric(Type type, Material * material)
+			: m_type(type), m_material(material)
+		{
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Type Quadric::type() const
+		///
+		/// \brief	Gets the shape.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The shape.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Type type() const
+		{ return m_type ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Material * Quadric::material() const
+		///
+		/// \brief	Gets the material.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The material.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Material * material() const
+		{ return m_material ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	BoundingBox const & Quadric::boundingBox() const
+		///
+		/// \brief	Gets the bounding box of the primitive.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The bounding box.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		BoundingBox const & boundingBox() const
+		{ return m_boundingBox ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Quadric::intersection(Ray const & ray, float & t) const
+		///
+		/// \brief	Computes the nearest intersection between a ray and this primitive.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray		   	The ray.
+		/// \param [in,out]	t	The distance of the nearest intersection found so far, replaced by the
+		/// 					distance of the intersection with this primitive if it is nearer.
+		///
+		/// \return	true if a nearer intersection has been found.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool intersection(Ray const & ray, float & t) const
+		{
+			float tNearest ;
+			if(!nearest(ray, t, tNearest)) { return false ; }
+			t = tNearest ;
+			return true ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Quadric::occluded(Ray const & ray, float tMax) const
+		///
+		/// \brief	Tests if the primitive intersects a ray before a given distance (shadow rays).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray 	The ray.
+		/// \param	tMax	The maximum distance on the ray.
+		///
+		/// \return	true if the ray is blocked.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool occluded(Ray const & ray, float tMax) const
+		{
+			float t ;
+			return nearest(ray, tMax, t) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 Quadric::normal(Math::Vector3 const & point) const
+		///
+		/// \brief	Gets the outward normal of the primitive at a point of its surface. On closed
+		/// 		cylinders and cones, the side or the cap is chosen by the distance of the point to
+		/// 		each surface.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	point	The point (in world space).
+		///
+		/// \return	The normalized normal (in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 normal(Math::Vector3 const & point) const
+		{
+			Math::Vector3 offset = m_transform.toLocal(point) ;
+			float x = offset[0] ;
+			float y = offset[1] ;
+			float z = offset[2] ;
+			float r = sqrt(x*x+y*y) ;
+			Math::Vector3 local(0.0f, 0.0f, 1.0f) ;
+			switch(m_type)
+			{
+			case sphere:
+				local = Math::Vector3(x, y, z) ;
+				break ;
+			case cylinder:
+				if(fabs(r-1.0f)<fabs(fabs(z)-0.5f)) { local = Math::Vector3(x, y, 0.0f) ; }
+				else if(z<0.0f) { local = Math::Vector3(0.0f, 0.0f, -1.0f) ; }
+				break ;
+			case cone:
+				// The gradient of x^2 + y^2 - (0.5 - z)^2 is (x, y, 0.5 - z) = (x, y, r) on the side
+				if(fabs(z+0.5f)<fabs(r-(0.5f-z))) { local = Math::Vector3(0.0f, 0.0f, -1.0f) ; }
+				else if(r>0.0f) { local = Math::Vector3(x/r, y/r, 1.0f) ; }
+				break ;
+			case disk:
+				break ;
+			}
+			return m_transform.normalToWorld(local) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::translate(Math::Vector3 const & t)
+		///
+		/// \brief	Translates this primitive.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	t	The translation vector.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void translate(Math::Vector3 const & t)
+		{
+			m_transform.translate(t) ;
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::scale(float v)
+		///
+		/// \brief	Applies a scale factor on this primitive (relatively to the world origin, as
+		/// 		Geometry::scale).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	v	The scale factor.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scale(float v)
+		{
+			m_transform.scale(v) ;
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::scaleX(float v)
+		///
+		/// \brief	Scales this primitive on X axis.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	v	The scale factor on X axis.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scaleX(float v)
+		{ scaleAxis(0, v) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::scaleY(float v)
+		///
+		/// \brief	Scales this primitive on Y axis.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	v	The scale factor on Y axis.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scaleY(float v)
+		{ scaleAxis(1, v) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::scaleZ(float v)
+		///
+		/// \brief	Scales this primitive on Z axis.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	v	The scale factor on Z axis.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scaleZ(float v)
+		{ scaleAxis(2, v) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::scaleAxis(int axis, float v)
+		///
+		/// \brief	Scales this primitive on a world axis.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	axis	The axis (0, 1 or 2).
+		/// \param	v   	The scale factor.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scaleAxis(int axis, float v)
+		{
+			m_transform.scaleAxis(axis, v) ;
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Quadric::rotate(Math::Quaternion const & q)
+		///
+		/// \brief	Rotates this primitive (around the world origin, as Geometry::rotate).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	q	Quaternion describing the rotation.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void rotate(Math::Quaternion const & q)
+		{
+			m_transform.rotate(q) ;
+			update() ;
+		}
+	} ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	// RayTriangleIntersection methods depending on Quadric (declared in
+	// Geometry/RayTriangleIntersection.h).
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Material * RayTriangleIntersection::material() const
+	{
+		return m_triangle!=NULL ? m_triangle->material() : m_quadric->material() ;
+	}
+
+	Math::Vector3 RayTriangleIntersection::normal() const
+	{
+		if(m_triangle==NULL) { return m_quadric->normal(intersection()) ; }
+		if(m_transform==NULL) { return m_triangle->normal() ; }
+		// Orientation of the triangle built on the transformed vertices (reversed by mirror transforms)
+		Math::Vector3 n = m_transform->normalToWorld(m_triangle->normal()) ;
+		return m_transform->determinant()<0.0f ? n*(-1.0f) : n ;
+	}
+}
+
+#endif
@@ -40,9 +40,11 @@ namespace Geometry
 			: m_source(source), m_direction(direction/direction.norm())
 		{
 			m_invDirection = m_direction.simdInv() ;
-			m_sign[0] = m_direction[0]<0.0 ;
-			m_sign[1] = m_direction[1]<0.0 ;
-			m_sign[2] = m_direction[2]<0.0 ;
+			// Signs are taken from the inverse direction so that -0.0 coordinates (inverse = -inf) 
+			// select the correct slabs during ray / box intersection.
+			m_sign[0] = m_invDirection[0]<0.0 ;
+			m_sign[1] = m_invDirection[1]<0.0 ;
+			m_sign[2] = m_invDirection[2]<0.0 ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,362 @@
+#ifndef _Geometry_RayPacket_H
+#define _Geometry_RayPacket_H
+
+#include <limits>
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+#include <xmmintrin.h>
+#include <Geometry/Ray.h>
+#include <Geometry/RayTriangleIntersection.h>
+#include <Geometry/TriangleBlock.h>
+
+/// \brief	Side (in pixels) of the square tiles of primary rays traced as packets (4 or 8). Can be
+/// 		overridden in the project settings.
+#ifndef PACKET_TILE_SIZE
+#define PACKET_TILE_SIZE 4
+#endif
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RayPacket
+	///
+	/// \brief	A packet of Size coherent rays (Size is a multiple of 4) stored as structure of arrays.
+	/// 		The packet is bounded by intervals on the sources and on the inverse directions, which
+	/// 		are used to cull whole nodes with interval arithmetic. This is only valid if the
+	/// 		directions of all the rays have the same signs (see RayPacket::coherent), otherwise the
+	/// 		rays should be traced one by one. The packet also stores the nearest intersection of
+	/// 		each ray.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <int Size>
+	class RayPacket
+	{
+	protected:
+		/// \brief	The lower bound of the sources, broadcast on each axis.
+		__m128 m_sourceMin[3] ;
+		/// \brief	The upper bound of the sources, broadcast on each axis.
+		__m128 m_sourceMax[3] ;
+		/// \brief	The lower bound of the inverse directions, broadcast on each axis.
+		__m128 m_invDirectionMin[3] ;
+		/// \brief	The upper bound of the inverse directions, broadcast on each axis.
+		__m128 m_invDirectionMax[3] ;
+		/// \brief	The sources of the rays: m_source[axis][ray].
+		float m_source[3][Size] ;
+		/// \brief	The directions of the rays: m_direction[axis][ray].
+		float m_direction[3][Size] ;
+		/// \brief	Distance of the nearest intersection of each ray (max float if none).
+		float m_t[Size] ;
+		/// \brief	The u coordinate of the nearest intersection of each ray.
+		float m_u[Size] ;
+		/// \brief	The v coordinate of the nearest intersection of each ray.
+		float m_v[Size] ;
+		/// \brief	The nearest intersected triangle of each ray (NULL if none).
+		const Triangle * m_triangle[Size] ;
+		/// \brief	The nearest intersected analytic primitive of each ray (NULL if none).
+		const Quadric * m_quadric[Size] ;
+		/// \brief	The transform of the instance of the nearest intersected triangle of each ray (NULL
+		/// 		if the triangle is in world space).
+		const Math::Transform * m_transform[Size] ;
+		/// \brief	The rays.
+		const Ray * m_rays[Size] ;
+		/// \brief	Number of rays in the packet (unused slots duplicate the last ray).
+		int m_count ;
+		/// \brief	The sign of the inverse directions (common to all the rays if coherent).
+		int m_sign[3] ;
+		/// \brief	true if all directions have the same signs and no null coordinate.
+		bool m_coherent ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RayPacket::RayPacket(const Ray * rays, int count)
+		///
+		/// \brief	Builds a packet from an array of rays.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	rays 	The rays (they should live as long as the packet).
+		/// \param	count	The number of rays, between 1 and Size.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RayPacket(const Ray * rays, int count)
+			: m_count(count), m_coherent(true)
+		{
+			assert(count>0 && count<=Size) ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_sign[axis] = rays[0].getSign()[axis] ;
+			}
+			float sourceMin[3], sourceMax[3], invMin[3], invMax[3] ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				sourceMin[axis] = sourceMax[axis] = rays[0].source()[axis] ;
+				invMin[axis] = invMax[axis] = rays[0].invDirection()[axis] ;
+			}
+			for(int cpt=0 ; cpt<Size ; ++cpt)
+			{
+				const Ray & ray = rays[::std::min(cpt, count-1)] ;
+				m_rays[cpt] = &ray ;
+				m_t[cpt] = ::std::numeric_limits<float>::max() ;
+				m_u[cpt] = m_v[cpt] = 0.0f ;
+				m_triangle[cpt] = NULL ;
+				m_quadric[cpt] = NULL ;
+				m_transform[cpt] = NULL ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					m_source[axis][cpt] = ray.source()[axis] ;
+					m_direction[axis][cpt] = ray.direction()[axis] ;
+					float inv = ray.invDirection()[axis] ;
+					m_coherent &= (ray.getSign()[axis]==m_sign[axis]) && fabs(inv)<=::std::numeric_limits<float>::max() ;
+					sourceMin[axis] = ::std::min(sourceMin[axis], ray.source()[axis]) ;
+					sourceMax[axis] = ::std::max(sourceMax[axis], ray.source()[axis]) ;
+					invMin[axis] = ::std::min(invMin[axis], inv) ;
+					invMax[axis] = ::std::max(invMax[axis], inv) ;
+				}
+			}
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_sourceMin[axis] = _mm_set1_ps(sourceMin[axis]) ;
+				m_sourceMax[axis] = _mm_set1_ps(sourceMax[axis]) ;
+				m_invDirectionMin[axis] = _mm_set1_ps(invMin[axis]) ;
+				m_invDirectionMax[axis] = _mm_set1_ps(invMax[axis]) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool RayPacket::coherent() const
+		///
+		/// \brief	Tells if the packet can be traced as a whole (same direction signs for all the rays).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if coherent, false if the rays should be traced one by one.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool coherent() const
+		{ return m_coherent ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int RayPacket::size() const
+		///
+		/// \brief	Gets the number of rays of the packet.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The number of rays.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int size() const
+		{ return m_count ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Ray & RayPacket::ray(int index) const
+		///
+		/// \brief	Gets a ray of the packet.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the ray.
+		///
+		/// \return	The ray.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Ray & ray(int index) const
+		{ return *m_rays[index] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float RayPacket::distance(int index) const
+		///
+		/// \brief	Gets the distance of the nearest intersection of a ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the ray.
+		///
+		/// \return	The distance (max float if the ray does not hit the scene).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float distance(int index) const
+		{ return m_t[index] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float RayPacket::maxDistance() const
+		///
+		/// \brief	Gets the largest distance of the nearest intersections of the rays. Nodes farther
+		/// 		than this distance cannot contain a nearer intersection for any ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The largest distance.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float maxDistance() const
+		{
+			__m128 result = _mm_loadu_ps(m_t) ;
+			for(int first=4 ; first<Size ; first+=4)
+			{
+				result = _mm_max_ps(result, _mm_loadu_ps(m_t+first)) ;
+			}
+			float values[4] ;
+			_mm_storeu_ps(values, result) ;
+			return ::std::max(::std::max(values[0], values[1]), ::std::max(values[2], values[3])) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RayPacket::set(int index, RayTriangleIntersection const & intersection)
+		///
+		/// \brief	Sets the nearest intersection of a ray (used when the rays are traced one by one).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index			Zero-based index of the ray.
+		/// \param	intersection	The intersection.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void set(int index, RayTriangleIntersection const & intersection)
+		{
+			if(!intersection.valid()) { return ; }
+			m_t[index] = intersection.tRayValue() ;
+			m_u[index] = intersection.uTriangleValue() ;
+			m_v[index] = intersection.vTriangleValue() ;
+			m_triangle[index] = intersection.triangle() ;
+			m_quadric[index] = intersection.quadric() ;
+			m_transform[index] = intersection.transform() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RayTriangleIntersection RayPacket::intersection(int index) const
+		///
+		/// \brief	Gets the nearest intersection of a ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the ray.
+		///
+		/// \return	The intersection (invalid if the ray does not hit the scene).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RayTriangleIntersection intersection(int index) const
+		{
+			if(m_quadric[index]!=NULL) { return RayTriangleIntersection(m_quadric[index], m_rays[index], m_t[index]) ; }
+			if(m_triangle[index]==NULL) { return RayTriangleIntersection(m_rays[index]) ; }
+			return RayTriangleIntersection(m_triangle[index], m_rays[index], m_t[index], m_u[index], m_v[index], m_transform[index]) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <int Width> int RayPacket::intersect(const float (&bounds)[2][3][Width],
+		/// 	float tMax, float * tEntry) const
+		///
+		/// \brief	Conservative intersection between the packet and the Width children boxes of a wide
+		/// 		node (see WideBVH). The slab distances are bounded with interval arithmetic on the
+		/// 		sources and inverse directions of the packet: a box is culled only if no ray of the
+		/// 		packet can intersect it. The packet should be coherent.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	bounds		  	The bounds of the boxes (16 bytes aligned).
+		/// \param	tMax		  	The maximum distance on the rays.
+		/// \param [out]	tEntry	Lower bounds of the entry distances of the rays in the boxes.
+		///
+		/// \return	The mask of the boxes that may be intersected by the packet.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <int Width>
+		int intersect(const float (&bounds)[2][3][Width], float tMax, float * tEntry) const
+		{
+			int mask = 0 ;
+			for(int first=0 ; first<Width ; first+=4)
+			{
+				__m128 tNear = _mm_setzero_ps() ;
+				__m128 tFar = _mm_set1_ps(tMax) ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					__m128 nearPlane = _mm_load_ps(bounds[m_sign[axis]][axis]+first) ;
+					__m128 farPlane = _mm_load_ps(bounds[1-m_sign[axis]][axis]+first) ;
+					// Intervals of (plane - source)
+					__m128 nearLow = _mm_sub_ps(nearPlane, m_sourceMax[axis]) ;
+					__m128 nearHigh = _mm_sub_ps(nearPlane, m_sourceMin[axis]) ;
+					__m128 farLow = _mm_sub_ps(farPlane, m_sourceMax[axis]) ;
+					__m128 farHigh = _mm_sub_ps(farPlane, m_sourceMin[axis]) ;
+					// Lower bound of the entry distance, upper bound of the exit distance
+					__m128 t0 = _mm_min_ps(_mm_min_ps(_mm_mul_ps(nearLow, m_invDirectionMin[axis]), _mm_mul_ps(nearLow, m_invDirectionMax[axis])),
+										   _mm_min_ps(_mm_mul_ps(nearHigh, m_invDirectionMin[axis]), _mm_mul_ps(nearHigh, m_invDirectionMax[axis]))) ;
+					__m128 t1 = _mm_max_ps(_mm_max_ps(_mm_mul_ps(farLow, m_invDirectionMin[axis]), _mm_mul_ps(farLow, m_invDirectionMax[axis])),
+										   _mm_max_ps(_mm_mul_ps(farHigh, m_invDirectionMin[axis]), _mm_mul_ps(farHigh, m_invDirectionMax[axis]))) ;
+					tNear = _mm_max_ps(t0, tNear) ;
+					tFar = _mm_min_ps(t1, tFar) ;
+				}
+				_mm_storeu_ps(tEntry+first, tNear) ;
+				mask |= _mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) << first ;
+			}
+			return mask ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <int Width, class TriangleContainer> void RayPacket::intersect(
+		/// 	TriangleBlock<Width> const & block, TriangleContainer const & triangles)
+		///
+		/// \brief	Intersects all the rays of the packet with the triangles of a block and updates the
+		/// 		nearest intersection of each ray. Each triangle is broadcast and tested against four
+		/// 		rays at once (Mller-Trumbore, same tests as Triangle::intersection).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	TriangleContainer	Container of the triangles indexed by the block.
+		/// \param	block	 	The block.
+		/// \param	triangles	The triangles referenced by the block.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <int Width, class TriangleContainer>
+		void intersect(TriangleBlock<Width> const & block, TriangleContainer const & triangles)
+		{
+			for(int slot=0 ; slot<Width ; ++slot)
+			{
+				if(block.m_triangle[slot]<0) { continue ; }
+				__m128 v0x = _mm_set1_ps(block.m_vertex0[0][slot]), v0y = _mm_set1_ps(block.m_vertex0[1][slot]), v0z = _mm_set1_ps(block.m_vertex0[2][slot]) ;
+				__m128 e1x = _mm_set1_ps(block.m_edge1[0][slot]), e1y = _mm_set1_ps(block.m_edge1[1][slot]), e1z = _mm_set1_ps(block.m_edge1[2][slot]) ;
+				__m128 e2x = _mm_set1_ps(block.m_edge2[0][slot]), e2y = _mm_set1_ps(block.m_edge2[1][slot]), e2z = _mm_set1_ps(block.m_edge2[2][slot]) ;
+				for(int first=0 ; first<Size ; first+=4)
+				{
+					__m128 dx = _mm_loadu_ps(m_direction[0]+first), dy = _mm_loadu_ps(m_direction[1]+first), dz = _mm_loadu_ps(m_direction[2]+first) ;
+					// pvec = direction ^ edge2
+					__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y)) ;
+					__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z)) ;
+					__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x)) ;
+					__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz)) ;
+					__m128 valid = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), det), _mm_set1_ps(0.000000001f)) ;
+					__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det) ;
+					// tvec = source - vertex0
+					__m128 tx = _mm_sub_ps(_mm_loadu_ps(m_source[0]+first), v0x) ;
+					__m128 ty = _mm_sub_ps(_mm_loadu_ps(m_source[1]+first), v0y) ;
+					__m128 tz = _mm_sub_ps(_mm_loadu_ps(m_source[2]+first), v0z) ;
+					__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet) ;
+					valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, _mm_setzero_ps()), _mm_cmple_ps(u, _mm_set1_ps(1.0f)))) ;
+					// qvec = tvec ^ edge1
+					__m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y)) ;
+					__m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z)) ;
+					__m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x)) ;
+					__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet) ;
+					valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, _mm_setzero_ps()), _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)))) ;
+					__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet) ;
+					__m128 tCurrent = _mm_loadu_ps(m_t+first) ;
+					valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(t, _mm_set1_ps(0.0001f)), _mm_cmplt_ps(t, tCurrent))) ;
+					int mask = _mm_movemask_ps(valid) ;
+					if(mask==0) { continue ; }
+					_mm_storeu_ps(m_t+first, _mm_or_ps(_mm_and_ps(valid, t), _mm_andnot_ps(valid, tCurrent))) ;
+					_mm_storeu_ps(m_u+first, _mm_or_ps(_mm_and_ps(valid, u), _mm_andnot_ps(valid, _mm_loadu_ps(m_u+first)))) ;
+					_mm_storeu_ps(m_v+first, _mm_or_ps(_mm_and_ps(valid, v), _mm_andnot_ps(valid, _mm_loadu_ps(m_v+first)))) ;
+					const Triangle * triangle = &triangles[block.m_triangle[slot]] ;
+					for(int lane=0 ; lane<4 ; ++lane)
+					{
+						if(mask & (1<<lane)) { m_triangle[first+lane] = triangle ; m_quadric[first+lane] = NULL ; m_transform[first+lane] = NULL ; }
+					}
+				}
+			}
+		}
+	} ;
+}
+
+#endif
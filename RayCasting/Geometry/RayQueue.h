@@ -0,0 +1,476 @@
+#ifndef _Geometry_RayQueue_H
+#define _Geometry_RayQueue_H
+
+#include <vector>
+#include <limits>
+#include <Math/Vector3.h>
+#include <Geometry/Ray.h>
+#include <Geometry/Triangle.h>
+#include <Geometry/RGBColor.h>
+#include <Geometry/RayTriangleIntersection.h>
+#include <System/aligned_allocator.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RayQueue
+	///
+	/// \brief	A queue of path segments exchanged between the stages of the wavefront renderer (see
+	/// 		Scene::computeWavefrontTile). Each entry stores a ray, the throughput of its path, the
+	/// 		pixel and the depth of the path, and the nearest intersection found by the extension
+	/// 		stage. Entries are stored as structure of arrays.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RayQueue
+	{
+	public:
+		/// \brief	A float array aligned for SIMD accesses.
+		typedef ::std::vector<float, aligned_allocator<float, 16> > FloatArray ;
+
+	protected:
+		/// \brief	The sources of the rays: m_source[axis][entry].
+		FloatArray m_source[3] ;
+		/// \brief	The directions of the rays: m_direction[axis][entry].
+		FloatArray m_direction[3] ;
+		/// \brief	The throughputs of the paths: m_throughput[component][entry].
+		FloatArray m_throughput[3] ;
+		/// \brief	The pixels of the paths.
+		::std::vector<int> m_pixel ;
+		/// \brief	The depths of the paths.
+		::std::vector<int> m_depth ;
+		/// \brief	The number of refractions of the paths.
+		::std::vector<int> m_refractionDepth ;
+		/// \brief	true if the emitted light of the nearest intersection is gathered (false if it is
+		/// 		already sampled by next event estimation).
+		::std::vector<char> m_emission ;
+		/// \brief	Distance of the nearest intersection.
+		FloatArray m_t ;
+		/// \brief	The u coordinate of the nearest intersection.
+		FloatArray m_u ;
+		/// \brief	The v coordinate of the nearest intersection.
+		FloatArray m_v ;
+		/// \brief	The nearest intersected triangle (NULL if none).
+		::std::vector<const Triangle *> m_triangle ;
+		/// \brief	The nearest intersected analytic primitive (NULL if none).
+		::std::vector<const Quadric *> m_quadric ;
+		/// \brief	The transform of the instance of the nearest intersected triangle (NULL if the
+		/// 		triangle is in world space).
+		::std::vector<const Math::Transform *> m_transform ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RayQueue::reserve(int capacity)
+		///
+		/// \brief	Reserves memory for capacity entries.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	capacity	The capacity.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void reserve(int capacity)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_source[axis].reserve(capacity) ;
+				m_direction[axis].reserve(capacity) ;
+				m_throughput[axis].reserve(capacity) ;
+			}
+			m_pixel.reserve(capacity) ;
+			m_depth.reserve(capacity) ;
+			m_refractionDepth.reserve(capacity) ;
+			m_emission.reserve(capacity) ;
+			m_t.reserve(capacity) ;
+			m_u.reserve(capacity) ;
+			m_v.reserve(capacity) ;
+			m_triangle.reserve(capacity) ;
+			m_quadric.reserve(capacity) ;
+			m_transform.reserve(capacity) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RayQueue::clear()
+		///
+		/// \brief	Removes all the entries (memory is kept).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void clear()
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_source[axis].clear() ;
+				m_direction[axis].clear() ;
+				m_throughput[axis].clear() ;
+			}
+			m_pixel.clear() ;
+			m_depth.clear() ;
+			m_refractionDepth.clear() ;
+			m_emission.clear() ;
+			m_t.clear() ;
+			m_u.clear() ;
+			m_v.clear() ;
+			m_triangle.clear() ;
+			m_quadric.clear() ;
+			m_transform.clear() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int RayQueue::size() const
+		///
+		/// \brief	Gets the number of entries.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The number of entries.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int size() const
+		{ return (int)m_pixel.size() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RayQueue::push(Ray const & ray, RGBColor const & throughput, int pixel, int depth,
+		/// 	int refractionDepth=0, bool emission=true)
+		///
+		/// \brief	Adds a path segment to the queue.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray		  	The ray.
+		/// \param	throughput	The throughput of the path.
+		/// \param	pixel	  	The pixel of the path.
+		/// \param	depth	  	The depth of the path (refractions excluded).
+		/// \param	refractionDepth	The number of refractions of the path.
+		/// \param	emission  	true if the emitted light of the hit surface should be gathered (it is
+		/// 					always gathered on analytic primitives, which are not light sampled).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void push(Ray const & ray, RGBColor const & throughput, int pixel, int depth, int refractionDepth=0, bool emission=true)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_source[axis].push_back(ray.source()[axis]) ;
+				m_direction[axis].push_back(ray.direction()[axis]) ;
+				m_throughput[axis].push_back(throughput[axis]) ;
+			}
+			m_pixel.push_back(pixel) ;
+			m_depth.push_back(depth) ;
+			m_refractionDepth.push_back(refractionDepth) ;
+			m_emission.push_back(emission) ;
+			m_t.push_back(::std::numeric_limits<float>::max()) ;
+			m_u.push_back(0.0f) ;
+			m_v.push_back(0.0f) ;
+			m_triangle.push_back(NULL) ;
+			m_quadric.push_back(NULL) ;
+			m_transform.push_back(NULL) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Ray RayQueue::ray(int index) const
+		///
+		/// \brief	Gets the ray of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The ray.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Ray ray(int index) const
+		{
+			return Ray(Math::Vector3(m_source[0][index], m_source[1][index], m_source[2][index]),
+					   Math::Vector3(m_direction[0][index], m_direction[1][index], m_direction[2][index])) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor RayQueue::throughput(int index) const
+		///
+		/// \brief	Gets the throughput of the path of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The throughput.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor throughput(int index) const
+		{ return RGBColor(m_throughput[0][index], m_throughput[1][index], m_throughput[2][index]) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int RayQueue::pixel(int index) const
+		///
+		/// \brief	Gets the pixel of the path of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The pixel.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int pixel(int index) const
+		{ return m_pixel[index] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int RayQueue::depth(int index) const
+		///
+		/// \brief	Gets the depth of the path of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The depth.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int depth(int index) const
+		{ return m_depth[index] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int RayQueue::refractionDepth(int index) const
+		///
+		/// \brief	Gets the number of refractions of the path of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The number of refractions.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int refractionDepth(int index) const
+		{ return m_refractionDepth[index] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool RayQueue::emission(int index) const
+		///
+		/// \brief	Tests if the emitted light of the surface hit by an entry should be gathered.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	false if the emitted light is already sampled by next event estimation.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool emission(int index) const
+		{ return m_emission[index]!=0 ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RayQueue::setIntersection(int index, RayTriangleIntersection const & intersection)
+		///
+		/// \brief	Stores the nearest intersection of the ray of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index			Zero-based index of the entry.
+		/// \param	intersection	The intersection.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setIntersection(int index, RayTriangleIntersection const & intersection)
+		{
+			if(!intersection.valid())
+			{
+				m_triangle[index] = NULL ;
+				m_quadric[index] = NULL ;
+				m_transform[index] = NULL ;
+				return ;
+			}
+			m_t[index] = intersection.tRayValue() ;
+			m_u[index] = intersection.uTriangleValue() ;
+			m_v[index] = intersection.vTriangleValue() ;
+			m_triangle[index] = intersection.triangle() ;
+			m_quadric[index] = intersection.quadric() ;
+			m_transform[index] = intersection.transform() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RayTriangleIntersection RayQueue::intersection(int index, Ray const & ray) const
+		///
+		/// \brief	Gets the nearest intersection of the ray of an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		/// \param	ray  	The ray of the entry (referenced by the intersection).
+		///
+		/// \return	The intersection (invalid if the ray does not hit the scene).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RayTriangleIntersection intersection(int index, Ray const & ray) const
+		{
+			if(m_quadric[index]!=NULL) { return RayTriangleIntersection(m_quadric[index], &ray, m_t[index]) ; }
+			if(m_triangle[index]==NULL) { return RayTriangleIntersection(&ray) ; }
+			return RayTriangleIntersection(m_triangle[index], &ray, m_t[index], m_u[index], m_v[index], m_transform[index]) ;
+		}
+	} ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	ShadowQueue
+	///
+	/// \brief	A queue of shadow rays built by the shading stage of the wavefront renderer. Each entry
+	/// 		stores a segment (shaded point, light position) and the contribution added to the pixel
+	/// 		if the segment is not occluded. Entries are stored as structure of arrays.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class ShadowQueue
+	{
+	protected:
+		/// \brief	The origins of the segments: m_origin[axis][entry].
+		RayQueue::FloatArray m_origin[3] ;
+		/// \brief	The targets of the segments: m_target[axis][entry].
+		RayQueue::FloatArray m_target[3] ;
+		/// \brief	The contributions: m_contribution[component][entry].
+		RayQueue::FloatArray m_contribution[3] ;
+		/// \brief	The pixels receiving the contributions.
+		::std::vector<int> m_pixel ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ShadowQueue::clear()
+		///
+		/// \brief	Removes all the entries (memory is kept).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void clear()
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_origin[axis].clear() ;
+				m_target[axis].clear() ;
+				m_contribution[axis].clear() ;
+			}
+			m_pixel.clear() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int ShadowQueue::size() const
+		///
+		/// \brief	Gets the number of entries.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The number of entries.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int size() const
+		{ return (int)m_pixel.size() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void ShadowQueue::push(Math::Vector3 const & origin, Math::Vector3 const & target,
+		/// 	RGBColor const & contribution, int pixel)
+		///
+		/// \brief	Adds a shadow ray to the queue.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	origin			The shaded point.
+		/// \param	target			The light position.
+		/// \param	contribution	The contribution if the light is visible.
+		/// \param	pixel			The pixel receiving the contribution.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void push(Math::Vector3 const & origin, Math::Vector3 const & target, RGBColor const & contribution, int pixel)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_origin[axis].push_back(origin[axis]) ;
+				m_target[axis].push_back(target[axis]) ;
+				m_contribution[axis].push_back(contribution[axis]) ;
+			}
+			m_pixel.push_back(pixel) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 ShadowQueue::origin(int index) const
+		///
+		/// \brief	Gets the origin of a shadow ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The origin.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 origin(int index) const
+		{ return Math::Vector3(m_origin[0][index], m_origin[1][index], m_origin[2][index]) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 ShadowQueue::target(int index) const
+		///
+		/// \brief	Gets the target of a shadow ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The target.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 target(int index) const
+		{ return Math::Vector3(m_target[0][index], m_target[1][index], m_target[2][index]) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor ShadowQueue::contribution(int index) const
+		///
+		/// \brief	Gets the contribution of a shadow ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The contribution.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor contribution(int index) const
+		{ return RGBColor(m_contribution[0][index], m_contribution[1][index], m_contribution[2][index]) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int ShadowQueue::pixel(int index) const
+		///
+		/// \brief	Gets the pixel receiving the contribution of a shadow ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Zero-based index of the entry.
+		///
+		/// \return	The pixel.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int pixel(int index) const
+		{ return m_pixel[index] ; }
+	} ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \struct	WavefrontQueues
+	///
+	/// \brief	The queues used by a thread of the wavefront renderer. They are kept from one tile to
+	/// 		the next one so that their memory is allocated once.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	struct WavefrontQueues
+	{
+		/// \brief	The rays of the current bounce.
+		RayQueue m_queue ;
+		/// \brief	The rays of the next bounce.
+		RayQueue m_next ;
+		/// \brief	The shadow rays of the current bounce.
+		ShadowQueue m_shadows ;
+		/// \brief	The radiance of the pixels of the current tile.
+		::std::vector<RGBColor> m_radiance ;
+	} ;
+}
+
+#endif
@@ -3,15 +3,23 @@
 
 #include <Geometry/Ray.h>
 #include <Geometry/Triangle.h>
+#include <Math/Transform.h>
 #include <Spy/Spy.h>
 #include <assert.h>
 
 namespace Geometry
 {
+	// Intersections may reference analytic primitives, methods related to primitives are defined at
+	// the end of Geometry/Quadric.h (which should be included to use them).
+	class Quadric ;
+
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// \class	RayTriangleIntersection
 	///
-	/// \brief	An intersection between a ray and a triangle.
+	/// \brief	An intersection between a ray and a triangle, or an analytic primitive (see Quadric).
+	/// 		The shading data (material, normal, reflected and refracted directions) should be
+	/// 		queried on the intersection, which handles both kinds of surfaces, and the triangles
+	/// 		of the shared meshes placed by a transform (see Instance).
 	///
 	/// \author	F. Lamarche, Universit de Rennes 1
 	/// \date	04/12/2013
@@ -29,6 +37,10 @@ namespace Geometry
 		bool m_valid ;
 		/// \brief	The triangle associated to the intersection.
 		const Triangle * m_triangle ;
+		/// \brief	The analytic primitive associated to the intersection (NULL for a triangle).
+		const Quadric * m_quadric ;
+		/// \brief	The transform of the instance of the triangle (NULL if the triangle is in world space).
+		const Math::Transform * m_transform ;
 		/// \brief	The ray associated to the intersection.
 		const Ray * m_ray ;
 
@@ -46,11 +58,51 @@ namespace Geometry
 		/// \param	ray			The ray.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		RayTriangleIntersection(const Triangle * triangle, const Ray * ray)
-			: m_triangle(triangle), m_ray(ray)
+			: m_triangle(triangle), m_quadric(NULL), m_transform(NULL), m_ray(ray)
 		{
 			m_valid=triangle->intersection(*ray, m_t, m_u, m_v) ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RayTriangleIntersection::RayTriangleIntersection(const Triangle * triangle,
+		/// 	const Ray * ray, float t, float u, float v, const Math::Transform * transform = NULL)
+		///
+		/// \brief	Constructor of a valid intersection that has already been computed (by an 
+		/// 		acceleration structure for instance). Avoids computing the intersection twice.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	triangle 	The triangle.
+		/// \param	ray		 	The ray.
+		/// \param	t		 	The distance between ray source and the intersection.
+		/// \param	u		 	The u coordinate of the intersection.
+		/// \param	v		 	The v coordinate of the intersection.
+		/// \param	transform	The transform of the instance of the triangle (NULL if the triangle is in
+		/// 					world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RayTriangleIntersection(const Triangle * triangle, const Ray * ray, float t, float u, float v, const Math::Transform * transform = NULL)
+			: m_t(t), m_u(u), m_v(v), m_valid(true), m_triangle(triangle), m_quadric(NULL), m_transform(transform), m_ray(ray)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RayTriangleIntersection::RayTriangleIntersection(const Quadric * quadric,
+		/// 	const Ray * ray, float t)
+		///
+		/// \brief	Constructor of a valid intersection with an analytic primitive, already computed by
+		/// 		the acceleration structure (u and v are not used and set to 0).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	quadric	The primitive.
+		/// \param	ray	   	The ray.
+		/// \param	t	   	The distance between ray source and the intersection.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RayTriangleIntersection(const Quadric * quadric, const Ray * ray, float t)
+			: m_t(t), m_u(0.0f), m_v(0.0f), m_valid(true), m_triangle(NULL), m_quadric(quadric), m_transform(NULL), m_ray(ray)
+		{}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	RayTriangleIntersection::RayTriangleIntersection(const Ray * ray)
 		///
@@ -62,7 +114,7 @@ namespace Geometry
 		/// \param	ray	The ray.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		RayTriangleIntersection(const Ray * ray)
-			: m_valid(false), m_triangle(NULL), m_ray(ray)
+			: m_valid(false), m_triangle(NULL), m_quadric(NULL), m_transform(NULL), m_ray(ray)
 		{}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -125,11 +177,146 @@ namespace Geometry
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	04/12/2013
 		///
-		/// \return	The triangle.
+		/// \return	The triangle (NULL if the intersected surface is an analytic primitive).
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		const Triangle * triangle() const
 		{ return m_triangle ; }
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Quadric * RayTriangleIntersection::quadric() const
+		///
+		/// \brief	Returns the analytic primitive associated to the intersection.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The primitive (NULL if the intersected surface is a triangle).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Quadric * quadric() const
+		{ return m_quadric ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const Math::Transform * RayTriangleIntersection::transform() const
+		///
+		/// \brief	Returns the transform of the instance of the intersected triangle. The triangle is
+		/// 		then expressed in the frame of its shared mesh, while the intersection point and the
+		/// 		shading data are in world space.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The transform (NULL if the triangle is in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const Math::Transform * transform() const
+		{ return m_transform ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Material * RayTriangleIntersection::material() const
+		///
+		/// \brief	Gets the material of the intersected surface.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The material.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline Material * material() const ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 RayTriangleIntersection::normal() const
+		///
+		/// \brief	Gets the normal of the intersected surface at the intersection point (the triangle
+		/// 		normal, or the outward normal of the analytic primitive), in world space.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The normal.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline Math::Vector3 normal() const ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 RayTriangleIntersection::reflectionDirection(Math::Vector3 const & dir) const
+		///
+		/// \brief	Returns the direction of a reflected ray, from the direction of the incident ray
+		/// 		(see Triangle::reflectionDirection).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	dir	The direction of the incident ray.
+		///
+		/// \return	The direction of the reflected ray.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 reflectionDirection(Math::Vector3 const & dir) const
+		{
+			if(m_triangle!=NULL && m_transform==NULL) { return m_triangle->reflectionDirection(dir) ; }
+			Math::Vector3 n = normal() ;
+			return dir-n*(2.0f*(dir*n)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 RayTriangleIntersection::reflectionDirection(Ray const & ray) const
+		///
+		/// \brief	Returns the direction of the reflected ray from a ray description (the normal is
+		/// 		directed toward the ray source, see Triangle::reflectionDirection).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray	The incident ray.
+		///
+		/// \return	The direction of the reflected ray.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 reflectionDirection(Ray const & ray) const
+		{
+			if(m_triangle!=NULL && m_transform==NULL) { return m_triangle->reflectionDirection(ray) ; }
+			Math::Vector3 n = orientedNormal(ray) ;
+			return ray.direction()-n*(2.0f*(ray.direction()*n)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 RayTriangleIntersection::refractionDirection(Ray const & ray) const
+		///
+		/// \brief	Returns the direction of the refracted ray (same model as
+		/// 		Triangle::refractionDirection).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray	The incident ray.
+		///
+		/// \return	The direction of the refracted ray (not a number on total internal reflection).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 refractionDirection(Ray const & ray) const
+		{
+			if(m_triangle!=NULL && m_transform==NULL) { return m_triangle->refractionDirection(ray) ; }
+			Math::Vector3 n = orientedNormal(ray) ;
+			float refractionIndex = 1.0f/material()->refractionIndex() ;
+			float alpha = n*(-ray.direction()) ;
+			float beta = sqrt(1.0f-refractionIndex*refractionIndex*(1.0f-alpha*alpha)) ;
+			return ray.direction()*refractionIndex+n*(refractionIndex*alpha-beta) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 RayTriangleIntersection::orientedNormal(Ray const & ray) const
+		///
+		/// \brief	Gets the normal at the intersection point directed toward the source of a ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray	The ray.
+		///
+		/// \return	The normal.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 orientedNormal(Ray const & ray) const
+		{
+			Math::Vector3 n = normal() ;
+			if(n*(ray.source()-intersection())<=0.0f) { n = n*(-1.0f) ; }
+			return n ;
+		}
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	const Ray * RayTriangleIntersection::ray() const
 		///
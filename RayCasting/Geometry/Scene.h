@@ -2,15 +2,34 @@
 #define _Geometry_Scene_H
 
 #include <limits>
-#include <windows.h>
+#include <map>
+#include <ctime>
 #include <Geometry/Geometry.h>
+#include <Geometry/Quadric.h>
+#include <Geometry/Instance.h>
 #include <Geometry/PointLight.h>
-#include <Visualizer/Visualizer.h>
+#include <Visualizer/RenderTarget.h>
 #include <Geometry/Camera.h>
 #include <Geometry/BoundingBox.h>
+#include <Geometry/WideBVH.h>
+#include <Geometry/RayTriangleIntersection.h>
+#include <Geometry/RayPacket.h>
+#include <Geometry/RayQueue.h>
+#include <Geometry/TileScheduler.h>
+#include <Geometry/FrameBuffer.h>
+#include <Geometry/EmissiveTriangles.h>
+#include <Geometry/LightCache.h>
+#include <Geometry/Denoiser.h>
 #include <Math/RandomDirection.h>
-#include <windows.h>
+#include <Math/SobolSampler.h>
 #include <System/aligned_allocator.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef CPP11_OPT
+#include <chrono>
+#include <thread>
+#endif
 
 using namespace std;
 
@@ -31,22 +50,127 @@ namespace Geometry
 	public:
 		int count;		
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \enum	RenderMode
+		///
+		/// \brief	The rendering algorithms.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		enum RenderMode
+		{
+			/// \brief	Recursive ray tracing (Scene::sendRay).
+			recursiveRendering,
+			/// \brief	Path tracing with the wavefront renderer (Scene::computeWavefrontTile).
+			wavefrontPathTracing,
+			/// \brief	Path tracing, one path per primary ray (Scene::tracePath).
+			pathTracing
+		} ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \enum	SampleDimension
+		///
+		/// \brief	The dimensions of the samples of a pixel (see Math::SampleStream) used by the path
+		/// 		tracing modes. The jitter of the primary ray uses the first dimensions, then each vertex
+		/// 		of a path uses its own block of vertexDimensions dimensions (see
+		/// 		Scene::vertexDimension) whose offsets are given by lightDimension, rouletteDimension
+		/// 		and bounceDimension.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		enum SampleDimension
+		{
+			/// \brief	Jitter of the primary ray in the pixel (two dimensions).
+			jitterDimension = 0,
+			/// \brief	The first dimension of the first vertex.
+			firstVertexDimension = 4,
+			/// \brief	Point sampled on the emissive triangles (three dimensions).
+			lightDimension = 0,
+			/// \brief	Russian roulette (one dimension).
+			rouletteDimension = 3,
+			/// \brief	Lobe and direction of the bounce (three dimensions).
+			bounceDimension = 4,
+			/// \brief	The number of dimensions of a vertex.
+			vertexDimensions = 8
+		} ;
+
 	protected:
-		/// \brief	The visualizer (rendering target).
-		Visualizer::Visualizer * m_visu ;
-		/// \brief	The scene geometry (basic representation without any optimization).
+		/// \brief	The rendering target (window or offscreen image).
+		Visualizer::RenderTarget * m_visu ;
+		/// \brief	The meshes of the scene with their bounding box (in the frame of the mesh). A geometry
+		/// 		added several times (up to an affine transform) is stored once, as the shared mesh
+		/// 		of several instances.
 		::std::deque<::std::pair<BoundingBox, Geometry> > m_geometries ;
 		//Geometry m_geometry ;
+		/// \brief	The instances of the meshes (one per geometry added to the scene).
+		::std::deque<Instance, aligned_allocator<Instance, 16> > m_instances ;
+		/// \brief	The analytic primitives of the scene.
+		::std::deque<Quadric, aligned_allocator<Quadric, 16> > m_quadrics ;
 		/// \brief	The lights.
 		std::deque<PointLight, aligned_allocator<PointLight, 16> > m_lights ;
 		/// \brief	The camera.
 		Camera m_camera ;
+		/// \brief	The top level acceleration structure, built on the bounding boxes of m_instances
+		/// 		followed by the bounding boxes of m_quadrics (leaf indices greater than the number of
+		/// 		instances are analytic primitives). Each mesh owns the bottom level structure on its
+		/// 		triangles, traversed by the rays transformed in the frame of the mesh, analytic
+		/// 		primitives are intersected in closed form.
+		WideBVH<BVH_WIDTH> m_bvh ;
+		/// \brief	false if geometries or primitives have been added since the last build of m_bvh.
+		bool m_bvhUpToDate ;
+		/// \brief	true if primary rays are traced as packets (tiles of PACKET_TILE_SIZE^2 pixels).
+		bool m_primaryRayPackets ;
+		/// \brief	The emissive triangles of the scene (rebuilt with the acceleration structure).
+		EmissiveTriangles m_emissiveTriangles ;
+		/// \brief	true if the path tracing modes sample the emissive triangles at each bounce.
+		bool m_nextEventEstimation ;
+		/// \brief	The irradiance cache of the recursive renderer (kept until the scene is modified).
+		LightCache m_irradianceCache ;
+		/// \brief	true if the recursive renderer interpolates the indirect diffuse lighting from
+		/// 		m_irradianceCache (false by default).
+		bool m_irradianceCaching ;
+		/// \brief	The rendering algorithm.
+		RenderMode m_renderMode ;
+		/// \brief	The number of samples (rendering passes) per pixel of the path tracing modes.
+		int m_samplesPerPixel ;
+		/// \brief	The target relative error of the adaptive sampling (0 if disabled).
+		float m_adaptiveError ;
+		/// \brief	The number of samples of a pixel before its error is estimated.
+		int m_adaptiveMinSamples ;
+		/// \brief	The maximum number of samples of a pixel with adaptive sampling.
+		int m_adaptiveMaxSamples ;
+		/// \brief	The sampler providing the random numbers of the renderers.
+		const Math::Sampler * m_sampler ;
+		/// \brief	The sampler used if none is provided.
+		Math::SobolSampler m_defaultSampler ;
+		/// \brief	The depth from which paths are terminated by Russian roulette.
+		int m_rouletteDepth ;
+		/// \brief	The maximum number of refractions of a path (refractions do not count in the depth).
+		int m_maxRefractionDepth ;
+		/// \brief	Distributes the tiles of the image to the rendering threads.
+		TileScheduler m_scheduler ;
+		/// \brief	Accumulates the samples of the last rendering.
+		FrameBuffer m_frameBuffer ;
+		/// \brief	The tiles of m_frameBuffer rendered in the current pass, copied once finished (see
+		/// 		Scene::publish). The presentation thread only reads this buffer.
+		FrameBuffer m_displayBuffer ;
+#ifdef _OPENMP
+		/// \brief	Protects m_displayBuffer and m_stopRequested.
+		omp_lock_t m_displayLock ;
+#endif
+		/// \brief	true if the user asked to stop the rendering, copied from the rendering target by
+		/// 		the presentation thread (see Scene::present) for the rendering threads.
+		bool m_stopRequested ;
+		/// \brief	The period (in milliseconds) of the presentation of the frame buffer.
+		int m_presentationPeriod ;
+		/// \brief	The date (in seconds, see Scene::currentTime) of the last presentation.
+		double m_lastPresentation ;
+		/// \brief	The denoiser applied after the rendering.
+		Denoiser m_denoiser ;
+		/// \brief	true if the rendering is denoised (see Scene::useDenoiser).
+		bool m_denoising ;
 
 
 	public:
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	Scene::Scene(Visualizer::Visualizer * visu)
+		/// \fn	Scene::Scene(Visualizer::RenderTarget * visu)
 		///
 		/// \brief	Constructor.
 		///
@@ -55,25 +179,162 @@ namespace Geometry
 		///
 		/// \param [in,out]	visu	ifnon-null, the visu.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		Scene(Visualizer::Visualizer * visu)
-			: m_visu(visu),count(0)
-		{}
+		Scene(Visualizer::RenderTarget * visu)
+			: m_visu(visu),count(0), m_bvhUpToDate(false), m_primaryRayPackets(true), m_nextEventEstimation(true), m_irradianceCaching(false), m_renderMode(recursiveRendering), m_samplesPerPixel(64), m_adaptiveError(0.0f), m_adaptiveMinSamples(16), m_adaptiveMaxSamples(256), m_sampler(&m_defaultSampler), m_rouletteDepth(2), m_maxRefractionDepth(8), m_stopRequested(false), m_presentationPeriod(40), m_lastPresentation(0.0), m_denoising(false)
+		{
+#ifdef _OPENMP
+			omp_init_lock(&m_displayLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Scene::~Scene()
+		///
+		/// \brief	Destructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		~Scene()
+		{
+#ifdef _OPENMP
+			omp_destroy_lock(&m_displayLock) ;
+#endif
+		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	void Scene::add(const Geometry & geometry)
+		/// \fn	int Scene::add(const Geometry & geometry)
 		///
-		/// \brief	Adds a geometry to the scene.
+		/// \brief	Adds a geometry to the scene. If the geometry is a transformed copy of a mesh of
+		/// 		the scene (see Geometry::findTransform), the mesh is shared: only an instance placed
+		/// 		by the transform is added.
 		///
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	03/12/2013
 		///
 		/// \param	geometry The geometry to add.
+		/// 		
+		/// \return	The index of the geometry in the scene (see Scene::getGeometry).
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		void add(const Geometry & geometry)
+		int add(const Geometry & geometry)
 		{
 			//m_geometry.merge(geometry) 
-			BoundingBox box(geometry) ;
-			m_geometries.push_back(::std::make_pair(box, geometry)) ;
+			Math::Transform transform ;
+			const Geometry * mesh = NULL ;
+			for(auto it=m_geometries.begin(), end=m_geometries.end() ; it!=end && mesh==NULL ; ++it)
+			{
+				if(it->second.findTransform(geometry, transform)) { mesh = &it->second ; }
+			}
+			if(mesh==NULL)
+			{
+				BoundingBox box(geometry) ;
+				m_geometries.push_back(::std::make_pair(box, geometry)) ;
+				mesh = &m_geometries.back().second ;
+			}
+			m_instances.push_back(Instance(mesh, transform)) ;
+			m_bvhUpToDate = false ;
+			return (int)m_instances.size()-1 ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int Scene::addInstance(int index, Math::Transform const & transform)
+		///
+		/// \brief	Adds an instance of a geometry of the scene, placed where the geometry would be after
+		/// 		the transform. Equivalent to adding a transformed copy of the geometry, without
+		/// 		building the copy and searching the shared mesh.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	 	Index of the geometry, as returned by Scene::add.
+		/// \param	transform	The transform applied to the geometry.
+		///
+		/// \return	The index of the new geometry in the scene (see Scene::getGeometry).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int addInstance(int index, Math::Transform const & transform)
+		{
+			Math::Transform placement = m_instances[index].transform() ;
+			placement.transform(transform) ;
+			m_instances.push_back(Instance(m_instances[index].geometry(), placement)) ;
+			m_bvhUpToDate = false ;
+			return (int)m_instances.size()-1 ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Geometry & Scene::getGeometry(int index)
+		///
+		/// \brief	Gets a geometry of the scene in order to modify it. Only the acceleration structure of
+		/// 		the modified geometry is rebuilt by the next call to Scene::updateAccelerationStructure.
+		/// 		A shared mesh is first copied (the other instances are not modified) and the
+		/// 		transform of the instance is applied to the vertices, so that the returned geometry
+		/// 		is in world space.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Index of the geometry, as returned by Scene::add.
+		///
+		/// \return	The geometry.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Geometry & getGeometry(int index)
+		{
+			Instance & instance = m_instances[index] ;
+			int references = 0 ;
+			for(auto it=m_instances.begin(), end=m_instances.end() ; it!=end ; ++it)
+			{
+				if(it->geometry()==instance.geometry()) { ++references ; }
+			}
+			auto mesh = m_geometries.begin() ;
+			while(&mesh->second!=instance.geometry()) { ++mesh ; }
+			if(references==1 && instance.transform().identity()) { return mesh->second ; }
+			if(references>1)
+			{
+				m_geometries.push_back(::std::make_pair(mesh->first, mesh->second)) ;
+				mesh = m_geometries.end()-1 ;
+			}
+			if(!instance.transform().identity()) { mesh->second.transform(instance.transform()) ; }
+			instance = Instance(&mesh->second, Math::Transform()) ;
+			m_bvhUpToDate = false ;
+			return mesh->second ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int Scene::add(Quadric const & quadric)
+		///
+		/// \brief	Adds an analytic primitive to the scene.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	quadric	The primitive to add.
+		///
+		/// \return	The index of the primitive in the scene (see Scene::getQuadric).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int add(Quadric const & quadric)
+		{
+			m_quadrics.push_back(quadric) ;
+			m_bvhUpToDate = false ;
+			return (int)m_quadrics.size()-1 ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Quadric & Scene::getQuadric(int index)
+		///
+		/// \brief	Gets an analytic primitive of the scene in order to modify it. The top level
+		/// 		acceleration structure is rebuilt by the next call to
+		/// 		Scene::updateAccelerationStructure.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	Index of the primitive, as returned by Scene::add.
+		///
+		/// \return	The primitive.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Quadric & getQuadric(int index)
+		{
+			m_bvhUpToDate = false ;
+			return m_quadrics[index] ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -107,7 +368,234 @@ namespace Geometry
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	RGBColor Scene::sendRay(Ray const & ray, float limit, int depth, int maxDepth)
+		/// \fn	void Scene::usePrimaryRayPackets(bool use)
+		///
+		/// \brief	Enables or disables the tracing of primary rays as packets.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	use	true to trace tiles of primary rays as packets, false to trace rays one by one.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void usePrimaryRayPackets(bool use)
+		{
+			m_primaryRayPackets = use ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::useNextEventEstimation(bool use)
+		///
+		/// \brief	Enables or disables the explicit sampling of the emissive triangles (next event
+		/// 		estimation) in the path tracing modes.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	use	true to sample one point on the emissive triangles per bounce, false to gather
+		/// 			the emitted light only when paths hit the emissive triangles.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void useNextEventEstimation(bool use)
+		{
+			m_nextEventEstimation = use ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::useIrradianceCache(bool use, float accuracy=0.2f)
+		///
+		/// \brief	Enables or disables the irradiance cache of the recursive renderer (disabled by
+		/// 		default). The cached records are shared by the threads during a rendering pass and
+		/// 		the cache is cleared before each pass (see Scene::compute): each pass interpolates its
+		/// 		own estimates, whose noise is averaged by the frame buffer, rather than reusing the
+		/// 		estimates of the first pass. With the cache, the image is biased and depends on the
+		/// 		order in which the threads create the records, hence on the number of threads:
+		/// 		renderings are only reproducible without it.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	use			true to interpolate the indirect diffuse lighting from the cache.
+		/// \param	accuracy	The accuracy of the cache (see LightCache).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void useIrradianceCache(bool use, float accuracy=0.2f)
+		{
+			m_irradianceCaching = use ;
+			m_irradianceCache.setAccuracy(accuracy) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setRenderMode(RenderMode mode)
+		///
+		/// \brief	Sets the rendering algorithm used by Scene::compute.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	mode	The rendering algorithm.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setRenderMode(RenderMode mode)
+		{
+			m_renderMode = mode ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setSamplesPerPixel(int samples)
+		///
+		/// \brief	Sets the number of samples per pixel of the path tracing modes. Each sample is a
+		/// 		rendering pass (randomly jittered in the pixels) and the image is updated after each
+		/// 		pass.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	samples	The number of samples per pixel.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setSamplesPerPixel(int samples)
+		{
+			m_samplesPerPixel = samples ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setAdaptiveSampling(float targetError, int minSamples=16,
+		/// 	int maxSamples=256)
+		///
+		/// \brief	Enables the adaptive sampling of the path tracing modes. After each pass, the pixels
+		/// 		whose relative error is below the target (see FrameBuffer::updateActivePixels) stop
+		/// 		receiving samples. The sample budget of the rendering (Scene::setSamplesPerPixel
+		/// 		times the number of pixels) is then spent on the remaining pixels, up to maxSamples
+		/// 		samples per pixel. The rendering ends when all the pixels converged or the budget is
+		/// 		spent.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	targetError	The target relative error (0 disables the adaptive sampling).
+		/// \param	minSamples 	The number of samples of a pixel before its error is estimated.
+		/// \param	maxSamples 	The maximum number of samples of a pixel.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setAdaptiveSampling(float targetError, int minSamples=16, int maxSamples=256)
+		{
+			m_adaptiveError = targetError ;
+			m_adaptiveMinSamples = minSamples ;
+			m_adaptiveMaxSamples = maxSamples ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setSampler(const Math::Sampler * sampler)
+		///
+		/// \brief	Sets the sampler providing the random numbers of the renderers (owned by the caller).
+		/// 		The default sampler is an Owen scrambled Sobol sampler (Math::SobolSampler).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	sampler	The sampler (NULL restores the default sampler).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setSampler(const Math::Sampler * sampler)
+		{
+			m_sampler = (sampler==NULL) ? &m_defaultSampler : sampler ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setRouletteDepth(int depth)
+		///
+		/// \brief	Sets the depth from which paths carrying little energy are terminated by Russian
+		/// 		roulette (see Scene::survivalProbability). Paths are always terminated at the
+		/// 		maximum depth provided to Scene::compute.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	depth	The depth (number of bounces, refractions included).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setRouletteDepth(int depth)
+		{
+			m_rouletteDepth = depth ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setMaxRefractionDepth(int depth)
+		///
+		/// \brief	Sets the maximum number of refractions of a path, in all the rendering modes.
+		/// 		Refractions do not count in the depth limited by Scene::compute, so that objects seen
+		/// 		through transparent objects are shaded as other objects.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	depth	The maximum number of refractions.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setMaxRefractionDepth(int depth)
+		{
+			m_maxRefractionDepth = depth ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::setPresentationPeriod(int milliseconds)
+		///
+		/// \brief	Sets the period of the presentation of the frame buffer in the rendering target
+		/// 		during Scene::compute.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	milliseconds	The period in milliseconds.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setPresentationPeriod(int milliseconds)
+		{
+			m_presentationPeriod = milliseconds ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	FrameBuffer const & Scene::frameBuffer() const
+		///
+		/// \brief	Gets the frame buffer of the last rendering (see Scene::compute).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The frame buffer.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		FrameBuffer const & frameBuffer() const
+		{
+			return m_frameBuffer ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::useDenoiser(bool use)
+		///
+		/// \brief	Enables or disables the denoising of the renderings: once all the passes are computed,
+		/// 		the features of the first hits are computed and the accumulated radiance is filtered
+		/// 		(see Denoiser). The denoised image is presented instead of the frame buffer.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	use	true to denoise the renderings.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void useDenoiser(bool use)
+		{
+			m_denoising = use ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Denoiser & Scene::denoiser()
+		///
+		/// \brief	Gets the denoiser (parameters and image of the last denoised rendering).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The denoiser.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Denoiser & denoiser()
+		{
+			return m_denoiser ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor Scene::sendRay(Ray const & ray, int depth, int maxDepth,
+		/// 	Math::SampleStream & samples, RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f),
+		/// 	int refractionDepth=0)
 		///
 		/// \brief	Sends a ray in the scene and returns the computed color
 		///
@@ -117,72 +605,282 @@ namespace Geometry
 		/// \param	ray			The ray.
 		/// \param	depth   	The current depth.
 		/// \param	maxDepth	The maximum depth.
+		/// \param [in,out]	samples	The samples of the pixel.
+		/// \param	throughput	   	The weight of the ray in the color of the pixel (Russian roulette).
+		/// \param	refractionDepth	The number of refractions of the ray.
+		///
+		/// \return	The computed color.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor sendRay(Ray const & ray, int depth, int maxDepth, Math::SampleStream & samples, RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f), int refractionDepth=0)
+		{
+			return shade(rayIntersection(ray), depth, maxDepth, samples, throughput, refractionDepth) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor Scene::shade(RayTriangleIntersection const & intersection, int depth,
+		/// 	int maxDepth, Math::SampleStream & samples,
+		/// 	RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f), int refractionDepth=0)
+		///
+		/// \brief	Computes the color carried by a ray from its nearest intersection with the scene.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	intersection	The nearest intersection of the ray.
+		/// \param	depth			The current depth.
+		/// \param	maxDepth		The maximum depth.
+		/// \param [in,out]	samples	The samples of the pixel.
+		/// \param	throughput	   	The weight of the ray in the color of the pixel (Russian roulette).
+		/// \param	refractionDepth	The number of refractions of the ray.
 		///
 		/// \return	The computed color.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		RGBColor sendRay(Ray const & ray, int depth, int maxDepth)
+		RGBColor shade(RayTriangleIntersection const & intersection, int depth, int maxDepth, Math::SampleStream & samples, RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f), int refractionDepth=0)
 		{
 			const int maxRays = 300;
 
-			//
+			// Le rayon ne rencontre aucun objet
+			if (!intersection.valid())
+				return RGBColor() ;
+
 			if (depth == maxDepth)
-				return emissiveColor(rayIntersection(ray));
+				return emissiveColor(intersection);
 			
 			else
 				// si le triangle intersect est "transparent"/"translucide" (indice de rfraction != 0)
-				if(rayIntersection(ray).triangle()->material()->refractionIndex() != 0)
-					//on relance un rayon suivant la direction refract de profondeur 2
-					return refraction(rayIntersection(ray));
+				if(intersection.material()->refractionIndex() != 0)
+					//on relance un rayon suivant la direction refracte, limit par le nombre de rfractions
+					return refraction(intersection, depth, maxDepth, samples, throughput, refractionDepth);
 				
 			
 				else
 					//On calcule les composantes diffuse et spculaire
-					//return diffuseColor(rayIntersection(ray)) + specular_indirectColor(rayIntersection(ray), depth, maxDepth);		
-					return global_diffuseColor(rayIntersection(ray),maxRays, depth, maxDepth) + global_specular_indirectColor(rayIntersection(ray),maxRays, depth, maxDepth);
+					//return diffuseColor(intersection) + specular_indirectColor(intersection, depth, maxDepth);		
+					return global_diffuseColor(intersection,maxRays, depth, maxDepth, samples, throughput, refractionDepth) + global_specular_indirectColor(intersection,maxRays, depth, maxDepth, samples, throughput, refractionDepth);
 		}
 
-		RayTriangleIntersection rayIntersection (Ray const & ray)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::updateAccelerationStructure()
+		///
+		/// \brief	Updates the two levels acceleration structure: the bottom level structure of each
+		/// 		modified mesh is rebuilt, then the top level structure on the bounding boxes of the
+		/// 		instances and of the analytic primitives is rebuilt if some geometry or primitive
+		/// 		moved or has been added. The registry of
+		/// 		the emissive triangles is rebuilt at the same time. Should be called each time the
+		/// 		scene is modified (Scene::compute calls it).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void updateAccelerationStructure()
 		{
-			int index_g = 0, index_t = 0;	
-			float profondeur_min = std::numeric_limits<float>::max();
+			bool modified = !m_bvhUpToDate ;
+			for(auto it=m_geometries.begin(), end=m_geometries.end() ; it!=end ; ++it)
+			{
+				if(!it->second.accelerationStructureUpToDate())
+				{
+					it->second.buildAccelerationStructure() ;
+					it->first.set(it->second) ;
+					modified = true ;
+				}
+			}
+			if(modified)
+			{
+				::std::map<const Geometry *, const BoundingBox *> meshBoxes ;
+				for(auto it=m_geometries.begin(), end=m_geometries.end() ; it!=end ; ++it)
+				{
+					meshBoxes[&it->second] = &it->first ;
+				}
+				::std::vector<BoundingBox, aligned_allocator<BoundingBox, 16> > boxes ;
+				boxes.reserve(m_instances.size()+m_quadrics.size()) ;
+				for(auto it=m_instances.begin(), end=m_instances.end() ; it!=end ; ++it)
+				{
+					it->update(*meshBoxes[it->geometry()]) ;
+					boxes.push_back(it->boundingBox()) ;
+				}
+				for(auto it=m_quadrics.begin(), end=m_quadrics.end() ; it!=end ; ++it)
+				{
+					boxes.push_back(it->boundingBox()) ;
+				}
+				m_bvh.build(boxes) ;
+				m_bvhUpToDate = true ;
 
-			CastedRay castedRay (ray.source(),ray.direction());
+				BoundingBox sceneBox ;
+				for(auto it=boxes.begin(), end=boxes.end() ; it!=end ; ++it)
+				{
+					sceneBox.update(*it) ;
+				}
+				m_irradianceCache.reset(sceneBox) ;
+
+				m_emissiveTriangles.clear() ;
+				for(auto it=m_instances.begin(), end=m_instances.end() ; it!=end ; ++it)
+				{
+					const ::std::deque<Triangle, aligned_allocator<Triangle, 16> > & triangles = it->geometry()->getTriangles() ;
+					for(auto triangle=triangles.begin(), last=triangles.end() ; triangle!=last ; ++triangle)
+					{
+						m_emissiveTriangles.add(*triangle, it->objectTransform()) ;
+					}
+				}
+				m_emissiveTriangles.build() ;
+			}
+		}
 
-			for(int i=0;i<(this->m_geometries).size();i++)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RayTriangleIntersection Scene::rayIntersection(Ray const & ray)
+		///
+		/// \brief	Computes the nearest intersection between a ray and the scene: the top level hierarchy
+		/// 		selects the instances whose bottom level hierarchy is traversed and the analytic
+		/// 		primitives which are intersected.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray	The ray.
+		///
+		/// \return	The nearest intersection (invalid if the ray does not hit the scene).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RayTriangleIntersection rayIntersection (Ray const & ray)
+		{
+			const Triangle * nearest = NULL ;
+			const Quadric * nearestQuadric = NULL ;
+			const Math::Transform * nearestTransform = NULL ;
+			float tMax = ::std::numeric_limits<float>::max() ;
+			float uNearest = 0.0f, vNearest = 0.0f ;
+			int instances = (int)m_instances.size() ;
+			// Read once for both levels of the traversal
+			CpuFeatures::InstructionSet instructionSet = CpuFeatures::instructionSet() ;
+
+			auto intersector = [&](int index, float & tCurrent) -> bool
 			{
-				for(int j=0;j<((this->m_geometries[i].second).getTriangles()).size();j++)
+				if(index<instances)
 				{
-					float profondeur, bidon2, bidon3;
+					const Instance & instance = m_instances[index] ;
+					if(!instance.intersection(ray, tCurrent, nearest, uNearest, vNearest, instructionSet)) { return false ; }
+					nearestQuadric = NULL ;
+					nearestTransform = instance.objectTransform() ;
+					return true ;
+				}
+				const Quadric & quadric = m_quadrics[index-instances] ;
+				if(!quadric.intersection(ray, tCurrent)) { return false ; }
+				nearestQuadric = &quadric ;
+				return true ;
+			} ;
+
+			if(m_bvh.intersect(ray, tMax, intersector, instructionSet))
+			{
+				if(nearestQuadric!=NULL) { return RayTriangleIntersection(nearestQuadric, &ray, tMax) ; }
+				return RayTriangleIntersection(nearest, &ray, tMax, uNearest, vNearest, nearestTransform) ;
+			}
+			return RayTriangleIntersection(&ray) ;
+		}
 
-					if(((this->m_geometries[i].second).getTriangles()[j]).intersection(ray,profondeur,bidon2,bidon3))
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <int Size> void Scene::rayIntersection(RayPacket<Size> & packet)
+		///
+		/// \brief	Computes the nearest intersections between a packet of rays and the scene. Coherent
+		/// 		packets traverse both levels of the acceleration structure together, other packets
+		/// 		fall back to one traversal per ray.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param [in,out]	packet	The packet receiving the nearest intersections.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <int Size>
+		void rayIntersection(RayPacket<Size> & packet)
+		{
+			if(!packet.coherent())
+			{
+				for(int cpt=0 ; cpt<packet.size() ; ++cpt)
+				{
+					packet.set(cpt, rayIntersection(packet.ray(cpt))) ;
+				}
+				return ;
+			}
+			int instances = (int)m_instances.size() ;
+			CpuFeatures::InstructionSet instructionSet = CpuFeatures::instructionSet() ;
+			auto intersector = [&](int index, RayPacket<Size> & current)
+			{
+				if(index<instances)
+				{
+					const Instance & instance = m_instances[index] ;
+					const Math::Transform * transform = instance.objectTransform() ;
+					if(transform==NULL)
+					{
+						instance.geometry()->intersection(current) ;
+						return ;
+					}
+					// Transformed instances are intersected ray by ray (each ray has its own scale)
+					for(int cpt=0 ; cpt<Size ; ++cpt)
 					{
-						if(profondeur < profondeur_min)
+						float t = current.distance(cpt) ;
+						const Triangle * triangle ;
+						float u, v ;
+						if(instance.intersection(current.ray(cpt), t, triangle, u, v, instructionSet))
 						{
-							profondeur_min = profondeur;
-							index_g = i;
-							index_t = j;
+							current.set(cpt, RayTriangleIntersection(triangle, &current.ray(cpt), t, u, v, transform)) ;
 						}
 					}
+					return ;
 				}
-			}
+				// Analytic primitives are intersected ray by ray
+				const Quadric & quadric = m_quadrics[index-instances] ;
+				for(int cpt=0 ; cpt<Size ; ++cpt)
+				{
+					float t = current.distance(cpt) ;
+					if(quadric.intersection(current.ray(cpt), t))
+					{
+						current.set(cpt, RayTriangleIntersection(&quadric, &current.ray(cpt), t)) ;
+					}
+				}
+			} ;
+			m_bvh.intersect(packet, intersector) ;
+		}
 
-			return RayTriangleIntersection(&((this->m_geometries[index_g].second).getTriangles()[index_t]), &ray);
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Scene::occluded(Math::Vector3 const & origin, Math::Vector3 const & target)
+		///
+		/// \brief	Tests if the segment between origin and target is blocked by the scene (shadow ray).
+		/// 		The traversal stops at the first blocker and intersections beyond target are ignored.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	origin	The origin of the segment (a point on a surface).
+		/// \param	target	The target of the segment (a light position).
+		///
+		/// \return	true if target is not visible from origin.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool occluded(Math::Vector3 const & origin, Math::Vector3 const & target)
+		{
+			Math::Vector3 direction = target-origin ;
+			float distance = direction.norm() ;
+			Ray ray(origin, direction/distance) ;
+			// Blockers closer to the target than the self intersection threshold are ignored
+			float tMax = distance-0.0001f ;
+
+			int instances = (int)m_instances.size() ;
+			CpuFeatures::InstructionSet instructionSet = CpuFeatures::instructionSet() ;
+			auto intersector = [&](int index, float & tCurrent) -> bool
+			{
+				if(index<instances) { return m_instances[index].occluded(ray, tCurrent, instructionSet) ; }
+				return m_quadrics[index-instances].occluded(ray, tCurrent) ;
+			} ;
+			return m_bvh.occluded(ray, tMax, intersector, instructionSet) ;
 		}
 
 		RGBColor diffuseColor(RayTriangleIntersection const & triangle_intersecte)
 		{
 			RGBColor diffuseReflection(0, 0, 0);
-			RGBColor Kd = triangle_intersecte.triangle()->material()->diffuseColor();
-			Math::Vector3 N = triangle_intersecte.triangle()->normal();
+			RGBColor Kd = triangle_intersecte.material()->diffuseColor();
+			Math::Vector3 N = triangle_intersecte.normal();
 
 			for(int i = 0; i<m_lights.size(); i++)
 			{
 				Math::Vector3 L = (m_lights[i].position() - (triangle_intersecte.intersection())) / ((m_lights[i].position() - (triangle_intersecte.intersection())).norm());
 
-				Ray light(m_lights[i].position(), -L);
-	
 				//Test des ombres
-				if(!shadow(light, triangle_intersecte.triangle()))
+				if(!occluded(triangle_intersecte.intersection(), m_lights[i].position()))
 				{
 					//On vrifie que la normale de l'objet est dans le bon sens
 					if(L * N < 0)
@@ -210,16 +908,16 @@ namespace Geometry
 
 		RGBColor emissiveColor(RayTriangleIntersection const & triangle_intersecte)
 		{
-			return triangle_intersecte.triangle()->material()->emissiveColor();
+			return triangle_intersecte.material()->emissiveColor();
 		}
 
 		RGBColor specular_directColor(RayTriangleIntersection const & triangle_intersecte)
 		{
 			RGBColor specular_directColor(0, 0, 0);
 
-			RGBColor Ks = (triangle_intersecte.triangle()->material())->specularColor();
-			Math::Vector3 N = triangle_intersecte.triangle()->normal();
-			int n = (triangle_intersecte.triangle()->material())->specularExponent();
+			RGBColor Ks = (triangle_intersecte.material())->specularColor();
+			Math::Vector3 N = triangle_intersecte.normal();
+			int n = (triangle_intersecte.material())->specularExponent();
 		
 
 			for(int i = 0; i < m_lights.size(); i++)
@@ -227,7 +925,7 @@ namespace Geometry
 				Math::Vector3 L = (m_lights[i].position() - (triangle_intersecte.intersection())) / ((m_lights[i].position() - (triangle_intersecte.intersection())).norm());
 				Ray light(m_lights[i].position(), -L);
 
-				if(!shadow(light, triangle_intersecte.triangle()))
+				if(!occluded(triangle_intersecte.intersection(), m_lights[i].position()))
 				{
 					if(L * N < 0)
 						N = N * -1;
@@ -242,7 +940,7 @@ namespace Geometry
 					//calcul du spculaire
 					float d = (m_lights[i].position() - (triangle_intersecte.intersection())).norm();
 
-					Math::Vector3 R = (triangle_intersecte.triangle()->reflectionDirection(light));
+					Math::Vector3 R = (triangle_intersecte.reflectionDirection(light));
 					Math::Vector3 V = (triangle_intersecte.ray()->source() - (triangle_intersecte.intersection())) / ((triangle_intersecte.ray()->source() - (triangle_intersecte.intersection())).norm());
 
 					float cosn = pow(R*V , n);
@@ -255,13 +953,13 @@ namespace Geometry
 		}
 
 
-		RGBColor specular_indirectColor(RayTriangleIntersection const & triangle_intersecte, int depth, int maxDepth)
+		RGBColor specular_indirectColor(RayTriangleIntersection const & triangle_intersecte, int depth, int maxDepth, Math::SampleStream & samples, RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f), int refractionDepth=0)
 		{
 			RGBColor specular_indirectColor(0, 0, 0);
 
-			RGBColor Ks = (triangle_intersecte.triangle()->material())->specularColor();
-			Math::Vector3 N = triangle_intersecte.triangle()->normal();
-			int n = (triangle_intersecte.triangle()->material())->specularExponent();
+			RGBColor Ks = (triangle_intersecte.material())->specularColor();
+			Math::Vector3 N = triangle_intersecte.normal();
+			int n = (triangle_intersecte.material())->specularExponent();
 		
 			if(Ks != 0)
 			{
@@ -270,7 +968,7 @@ namespace Geometry
 					Math::Vector3 L = (m_lights[i].position() - (triangle_intersecte.intersection())) / ((m_lights[i].position() - (triangle_intersecte.intersection())).norm());
 					Ray light(m_lights[i].position(), -L);
 
-					if(!shadow(light, triangle_intersecte.triangle()))
+					if(!occluded(triangle_intersecte.intersection(), m_lights[i].position()))
 					{
 						if(L * N < 0)
 							N = N * -1;
@@ -285,14 +983,14 @@ namespace Geometry
 
 						float d = (m_lights[i].position() - (triangle_intersecte.intersection())).norm();
 
-						Math::Vector3 R = (triangle_intersecte.triangle()->reflectionDirection(light));
+						Math::Vector3 R = (triangle_intersecte.reflectionDirection(light));
 						Math::Vector3 V = (triangle_intersecte.ray()->source() - (triangle_intersecte.intersection())) / ((triangle_intersecte.ray()->source() - (triangle_intersecte.intersection())).norm());
 
 						float cosn = pow(R*V , n);
 
 						//On ajoute la contributions d'autres objets pour le calcul du spculaire
-						Ray perfect_reflection((triangle_intersecte.intersection()), (triangle_intersecte.triangle()->reflectionDirection(triangle_intersecte.ray()->direction())));
-						specular_indirectColor = specular_indirectColor + (Ks * Isource * cosn / d) + sendRay(perfect_reflection,depth+1,maxDepth);
+						Ray perfect_reflection((triangle_intersecte.intersection()), (triangle_intersecte.reflectionDirection(triangle_intersecte.ray()->direction())));
+						specular_indirectColor = specular_indirectColor + (Ks * Isource * cosn / d) + sendRay(perfect_reflection,depth+1,maxDepth,samples,throughput,refractionDepth);
 					}
 				}
 			}
@@ -300,64 +998,110 @@ namespace Geometry
 			return specular_indirectColor;
 		}
 
-		RGBColor global_diffuseColor(RayTriangleIntersection const & triangle_intersecte, int const maxRays, int depth, int maxDepth)
+		RGBColor global_diffuseColor(RayTriangleIntersection const & triangle_intersecte, int const maxRays, int depth, int maxDepth, Math::SampleStream & samples, RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f), int refractionDepth=0)
 		{
 			RGBColor diffuseReflection = (0, 0, 0);// diffuseColor(ray, geo_tri);
 
 			RGBColor global_diffus = (0, 0, 0);
-			RGBColor Kd = triangle_intersecte.triangle()->material()->diffuseColor();
+			RGBColor Kd = triangle_intersecte.material()->diffuseColor();
 			float d = triangle_intersecte.tRayValue();
 			
 			//On ne travaille plus avec des sources ponctuelles mais avec des surfaces emissives
 			RGBColor surfaceLight = emissiveColor(triangle_intersecte);
 
-			Math::Vector3 N = triangle_intersecte.triangle()->normal();
+			Math::Vector3 N = triangle_intersecte.normal();
 			if ((-triangle_intersecte.ray()->direction()) * N < 0)
 				N = N * -1;
 
-			//Cration d'un gnrateur de direction suivant la loi cosinus
-			Math::RandomDirection random_generator(N);
-
 			if (Kd != 0)
 			{
-				//On rcupre la contributions des autres objets
-				for (int i = 0; i < maxRays; i++)
-				{
-					Math::Vector3 dir = random_generator.generate();
-					Ray diffuseRay((triangle_intersecte.intersection())/*+dir*0.1*/, dir);
-					global_diffus = global_diffus + (Kd * 1 * sendRay(diffuseRay, depth + 1, maxDepth) / d) + surfaceLight;
+				//Poids des rayons secondaires, les rayons de faible poids sont termins par roulette russe
+				RGBColor weight = Kd / d;
+
+				//L'clairement indirect est interpol depuis le cache s'il y est valide
+				RGBColor incoming;
+				if (m_irradianceCaching && m_irradianceCache.lookup(triangle_intersecte.intersection(), N, depth, incoming))
+					return surfaceLight + weight * incoming;
+
+				//Cration d'un gnrateur de direction suivant la loi cosinus
+				Math::RandomDirection random_generator(N);
+				float survival = survivalProbability(depth + 1 + refractionDepth, throughput * weight);
+
+				//Les directions sont gnres par lots de 8 (SSE)
+				Math::Vector3 directions[8];
+				float pdf[8];
+
+				//Somme des inverses des distances aux surfaces vues (rayon de validit de l'enregistrement)
+				float inverseDistances = 0.0f;
+				int tracedRays = 0;
+
+				//On rcupre la contributions des autres objets
+				for (int i = 0; i < maxRays; i++)
+				{
+					if (i % 8 == 0)
+						random_generator.generate(samples, ::std::min(8, maxRays - i), directions, pdf);
+					if (survival < 1.0f && samples.random() >= survival)
+						continue;
+					Math::Vector3 dir = directions[i % 8];
+					Ray diffuseRay((triangle_intersecte.intersection())/*+dir*0.1*/, dir);
+					RayTriangleIntersection hit = rayIntersection(diffuseRay);
+					if (hit.valid())
+						inverseDistances += 1.0f / hit.tRayValue();
+					tracedRays++;
+					incoming = incoming + shade(hit, depth + 1, maxDepth, samples, throughput * weight / survival, refractionDepth) / survival;
+				}
+
+				//On divise par le nombre de rayons gnrs pour moyenner le rsultat
+				incoming = incoming * (1.0f / maxRays);
+				if (m_irradianceCaching && tracedRays > 0)
+				{
+					float harmonicDistance = (inverseDistances > 0.0f) ? tracedRays / inverseDistances : ::std::numeric_limits<float>::max();
+					m_irradianceCache.insert(triangle_intersecte.intersection(), N, depth, incoming, harmonicDistance);
 				}
 
 				count++;
+				global_diffus = surfaceLight + weight * incoming;
 			}
 
-			//On divise par le nombre de rayons gnrs pour moyenner le rsultat
-			return  global_diffus*(1.0f / maxRays);
+			return global_diffus;
 		}
 
-		RGBColor global_specular_indirectColor(RayTriangleIntersection const & triangle_intersecte, int const maxRays, int depth, int maxDepth)
+		RGBColor global_specular_indirectColor(RayTriangleIntersection const & triangle_intersecte, int const maxRays, int depth, int maxDepth, Math::SampleStream & samples, RGBColor const & throughput=RGBColor(1.0f, 1.0f, 1.0f), int refractionDepth=0)
 		{
 			RGBColor specular_indirectColor(0, 0, 0);
 
-			RGBColor Ks = (triangle_intersecte.triangle()->material())->specularColor();
-			int sh = (triangle_intersecte.triangle()->material())->specularExponent();
+			RGBColor Ks = (triangle_intersecte.material())->specularColor();
+			int sh = (triangle_intersecte.material())->specularExponent();
 			float d = triangle_intersecte.tRayValue();
 			RGBColor surfaceLight = emissiveColor(triangle_intersecte);
 
 			if (Ks != 0)
 			{
-				Math::Vector3 N = triangle_intersecte.triangle()->normal();
+				Math::Vector3 N = triangle_intersecte.normal();
 				if ((-triangle_intersecte.ray()->direction()) * N < 0)
 					N = N * -1;
 
-				Math::Vector3 R = (triangle_intersecte.triangle()->reflectionDirection(*triangle_intersecte.ray()));
+				Math::Vector3 R = (triangle_intersecte.reflectionDirection(*triangle_intersecte.ray()));
 				Math::RandomDirection random_generator(R, sh);
 
+				//Poids des rayons secondaires, les rayons de faible poids sont termins par roulette russe
+				RGBColor weight = Ks / d;
+				float survival = survivalProbability(depth + 1 + refractionDepth, throughput * weight);
+
+				//Les directions sont gnres par lots de 8 (SSE)
+				Math::Vector3 directions[8];
+				float pdf[8];
+
 				for (int i = 0; i < maxRays; i++)
 				{
-					Math::Vector3 dir = random_generator.generate();
+					if (i % 8 == 0)
+						random_generator.generate(samples, ::std::min(8, maxRays - i), directions, pdf);
+					specular_indirectColor = specular_indirectColor + surfaceLight;
+					if (survival < 1.0f && samples.random() >= survival)
+						continue;
+					Math::Vector3 dir = directions[i % 8];
 					Ray specularRay(triangle_intersecte.intersection(), dir);
-					specular_indirectColor = specular_indirectColor + (Ks  * sendRay(specularRay, depth + 1, maxDepth) / d) + surfaceLight;
+					specular_indirectColor = specular_indirectColor + (weight * sendRay(specularRay, depth + 1, maxDepth, samples, throughput * weight / survival, refractionDepth) / survival);
 
 				}
 			}
@@ -366,92 +1110,943 @@ namespace Geometry
 		}
 
 
-		RGBColor refraction(RayTriangleIntersection const & triangle_intersecte)
+		RGBColor refraction(RayTriangleIntersection const & triangle_intersecte, int depth, int maxDepth, Math::SampleStream & samples, RGBColor const & throughput, int refractionDepth)
 		{
+			//Le nombre de rfractions d'un chemin est born (la profondeur n'est pas remise  zro)
+			if (refractionDepth >= m_maxRefractionDepth)
+				return emissiveColor(triangle_intersecte);
+
+			float survival = survivalProbability(depth + refractionDepth + 1, throughput);
+			if (survival < 1.0f && samples.random() >= survival)
+				return emissiveColor(triangle_intersecte);
+
 			//On cre un rayon dans la direction de la refraction et on rcupre la couleur de l'objet derrire
-			Ray refractionRay((triangle_intersecte.intersection()), (triangle_intersecte.triangle()->refractionDirection(*triangle_intersecte.ray())));
-			return sendRay(refractionRay, 0, 2);
+			Ray refractionRay((triangle_intersecte.intersection()), (triangle_intersecte.refractionDirection(*triangle_intersecte.ray())));
+			return sendRay(refractionRay, depth, maxDepth, samples, throughput / survival, refractionDepth + 1) / survival;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float Scene::survivalProbability(int depth, RGBColor const & throughput) const
+		///
+		/// \brief	Computes the probability that a path continues (Russian roulette). Before the roulette
+		/// 		depth (see Scene::setRouletteDepth), paths always continue. Beyond, the probability is
+		/// 		the largest component of the throughput, so that paths carrying little energy are
+		/// 		terminated early. Contributions of surviving paths must be divided by the probability.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	depth	  	The depth of the continuation (number of bounces, refractions included).
+		/// \param	throughput	The throughput of the path, including the weight of the continuation.
+		///
+		/// \return	The probability in ]0;1] (0 if the throughput is black).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float survivalProbability(int depth, RGBColor const & throughput) const
+		{
+			if(depth<m_rouletteDepth) { return 1.0f ; }
+			return ::std::min(1.0f, ::std::max(throughput[0], ::std::max(throughput[1], throughput[2]))) ;
+		}
+
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor Scene::pointLightColor(RayTriangleIntersection const & intersection,
+		/// 	PointLight const & light)
+		///
+		/// \brief	Computes the diffuse and specular light reflected toward the ray source by a point
+		/// 		light, without visibility test (same model as Scene::diffuseColor and
+		/// 		Scene::specular_directColor).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	intersection	The intersection.
+		/// \param	light			The light.
+		///
+		/// \return	The reflected color (black if the light and the ray source are on different sides).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor pointLightColor(RayTriangleIntersection const & intersection, PointLight const & light)
+		{
+			Math::Vector3 point = intersection.intersection() ;
+			Math::Vector3 toLight = light.position()-point ;
+			float d = toLight.norm() ;
+			Math::Vector3 L = toLight/d ;
+			Math::Vector3 N = intersection.normal() ;
+			if(L*N<0) { N = N*-1 ; }
+			// The ray source should be on the lit side of the triangle
+			if((intersection.ray()->direction()*(-1))*N<0) { return RGBColor() ; }
+
+			RGBColor result = intersection.material()->diffuseColor()*light.color()*(N*L)/d ;
+			RGBColor Ks = intersection.material()->specularColor() ;
+			if(Ks!=RGBColor())
+			{
+				Math::Vector3 R = intersection.reflectionDirection(Ray(light.position(), -L)) ;
+				Math::Vector3 V = intersection.ray()->direction()*(-1) ;
+				float cosine = R*V ;
+				if(cosine>0)
+				{
+					result = result+Ks*light.color()*pow(cosine, intersection.material()->specularExponent())/d ;
+				}
+			}
+			return result ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Scene::sampleBounce(RayTriangleIntersection const & intersection,
+		/// 	Math::SampleStream & samples, Math::Vector3 & direction, RGBColor & weight)
+		///
+		/// \brief	Samples the direction used to continue a path at an intersection (path tracing). 
+		/// 		Transparent materials continue in the refracted direction. Other materials choose
+		/// 		between their diffuse lobe (cosine distribution) and specular lobe (cosine^n around
+		/// 		the reflected direction) with a probability proportional to the largest component of
+		/// 		Kd and Ks.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	intersection	 	The intersection.
+		/// \param [in,out]	samples	 	The samples of the pixel (three dimensions are used).
+		/// \param [out]	direction	The sampled direction.
+		/// \param [out]	weight   	The factor applied to the throughput of the path.
+		///
+		/// \return	false if the path is absorbed.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool sampleBounce(RayTriangleIntersection const & intersection, Math::SampleStream & samples, Math::Vector3 & direction, RGBColor & weight)
+		{
+			const Material * material = intersection.material() ;
+			if(material->refractionIndex()!=0)
+			{
+				direction = intersection.refractionDirection(*intersection.ray()) ;
+				weight = RGBColor(1.0f, 1.0f, 1.0f) ;
+				// Total internal reflection
+				if(!(direction*direction>0)) { direction = intersection.reflectionDirection(*intersection.ray()) ; }
+				return true ;
+			}
+
+			RGBColor Kd = material->diffuseColor() ;
+			RGBColor Ks = material->specularColor() ;
+			float diffuseWeight = ::std::max(Kd[0], ::std::max(Kd[1], Kd[2])) ;
+			float specularWeight = ::std::max(Ks[0], ::std::max(Ks[1], Ks[2])) ;
+			float total = diffuseWeight+specularWeight ;
+			if(total<=0.0f) { return false ; }
+
+			Math::Vector3 N = intersection.normal() ;
+			if((-intersection.ray()->direction())*N<0) { N = N*-1 ; }
+			if(samples.random()*total<diffuseWeight)
+			{
+				direction = Math::RandomDirection(N).generate(samples) ;
+				weight = Kd*(total/diffuseWeight) ;
+			}
+			else
+			{
+				Math::Vector3 R = intersection.reflectionDirection(*intersection.ray()) ;
+				direction = Math::RandomDirection(R, material->specularExponent()).generate(samples) ;
+				weight = Ks*(total/specularWeight) ;
+			}
+			// Directions below the surface are absorbed
+			return direction*N>0 ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor Scene::reflectedCosine(RayTriangleIntersection const & intersection,
+		/// 	Math::Vector3 const & L)
+		///
+		/// \brief	Evaluates the reflectance of an intersection times the cosine of the incident
+		/// 		direction, for the model sampled by Scene::sampleBounce: Kd/pi for the diffuse lobe and
+		/// 		Ks(n+1)/(2pi).cos^n around the reflected direction for the specular lobe.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	intersection	The intersection.
+		/// \param	L				The (normalized) direction toward the incident light.
+		///
+		/// \return	The reflected fraction of the incident radiance (black if L and the ray source are
+		/// 		on different sides).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor reflectedCosine(RayTriangleIntersection const & intersection, Math::Vector3 const & L)
+		{
+			const Material * material = intersection.material() ;
+			Math::Vector3 N = intersection.normal() ;
+			if((-intersection.ray()->direction())*N<0) { N = N*-1 ; }
+			float cosine = N*L ;
+			if(cosine<=0.0f) { return RGBColor() ; }
+
+			const float pi = 3.14159265358979f ;
+			RGBColor result = material->diffuseColor()*(cosine/pi) ;
+			RGBColor Ks = material->specularColor() ;
+			if(Ks!=RGBColor())
+			{
+				Math::Vector3 R = intersection.reflectionDirection(*intersection.ray()) ;
+				float specular = R*L ;
+				if(specular>0.0f)
+				{
+					float n = material->specularExponent() ;
+					result = result+Ks*((n+1.0f)/(2.0f*pi)*pow(specular, n)) ;
+				}
+			}
+			return result ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Scene::sampleEmissiveLight(RayTriangleIntersection const & intersection,
+		/// 	Math::SampleStream & samples, Math::Vector3 & target, RGBColor & contribution)
+		///
+		/// \brief	Next event estimation: samples a point on the emissive triangles (area weighted, see
+		/// 		EmissiveTriangles) and computes the light it reflects toward the ray source. The
+		/// 		visibility of the point must be tested by the caller (shadow ray toward target).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	intersection			The intersection.
+		/// \param [in,out]	samples			The samples of the pixel (three dimensions are used).
+		/// \param [out]	target			The sampled point on the emissive triangle.
+		/// \param [out]	contribution	The reflected light if the point is visible.
+		///
+		/// \return	false if no light is sampled (no emissive triangle, transparent material or null
+		/// 		contribution).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool sampleEmissiveLight(RayTriangleIntersection const & intersection, Math::SampleStream & samples, Math::Vector3 & target, RGBColor & contribution)
+		{
+			if(m_emissiveTriangles.empty() || intersection.material()->refractionIndex()!=0) { return false ; }
+			float pdf ;
+			Math::Vector3 lightNormal ;
+			const Math::Transform * lightTransform ;
+			const Triangle * light = m_emissiveTriangles.sample(samples, target, lightNormal, pdf, lightTransform) ;
+			// Emitters do not light themselves (the triangles of shared meshes are distinct per instance)
+			if(light==intersection.triangle() && lightTransform==intersection.transform()) { return false ; }
+			Math::Vector3 toLight = target-intersection.intersection() ;
+			float squaredDistance = toLight*toLight ;
+			if(squaredDistance<=0.0f) { return false ; }
+			Math::Vector3 L = toLight/sqrt(squaredDistance) ;
+			RGBColor reflected = reflectedCosine(intersection, L) ;
+			if(reflected==RGBColor()) { return false ; }
+			// Conversion of the area density to the solid angle density
+			float lightCosine = fabs(lightNormal*L) ;
+			contribution = reflected*light->material()->emissiveColor()*(lightCosine/(squaredDistance*pdf)) ;
+			return contribution!=RGBColor() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static uint32_t Scene::vertexDimension(int vertex)
+		///
+		/// \brief	Computes the first dimension of the samples used at a vertex of a path (see
+		/// 		SampleDimension).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	vertex	The index of the vertex (number of bounces before the vertex).
+		///
+		/// \return	The dimension.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static uint32_t vertexDimension(int vertex)
+		{
+			return firstVertexDimension+vertex*vertexDimensions ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class RayContainer> void Scene::primaryRays(int x, int y, int columns, int rows,
+		/// 	int pass, float xp, float yp, RayContainer & rays)
+		///
+		/// \brief	Computes the primary rays of a packet tile of pixels (row major order). The recursive
+		/// 		renderer uses the offset of the pass, the path tracing modes jitter each pixel with the
+		/// 		samples of the pixel (see SampleDimension).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x				The column of the first pixel.
+		/// \param	y				The line of the first pixel.
+		/// \param	columns			The number of columns.
+		/// \param	rows			The number of rows.
+		/// \param	pass			The pass number (index of the samples).
+		/// \param	xp				The x offset of the sample in the pixels (recursive renderer).
+		/// \param	yp				The y offset of the sample in the pixels (recursive renderer).
+		/// \param [out]	rays	The container receiving the rays.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class RayContainer>
+		void primaryRays(int x, int y, int columns, int rows, int pass, float xp, float yp, RayContainer & rays)
+		{
+			float width = (float)m_visu->width() ;
+			float height = (float)m_visu->height() ;
+			if(m_renderMode==recursiveRendering)
+			{
+				m_camera.getRays(((float)x+xp)/width, ((float)y+yp)/height, 1.0f/width, 1.0f/height, columns, rows, rays) ;
+				return ;
+			}
+			for(int row=0 ; row<rows ; ++row)
+			{
+				for(int column=0 ; column<columns ; ++column)
+				{
+					Math::SampleStream samples(*m_sampler, (y+row)*m_visu->width()+x+column, pass, jitterDimension) ;
+					float jitterX = samples.random()-0.5f ;
+					float jitterY = samples.random()-0.5f ;
+					rays.push_back(m_camera.getRay(((float)(x+column)+jitterX)/width, ((float)(y+row)+jitterY)/height)) ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RGBColor Scene::tracePath(RayTriangleIntersection const & primary, int maxDepth,
+		/// 	Math::SampleStream & samples)
+		///
+		/// \brief	Path tracing: follows one sampled direction per bounce (see Scene::sampleBounce) and
+		/// 		gathers the emitted light and the direct lighting of the point lights along the path.
+		/// 		Paths end at maxDepth bounces (refractions being limited separately, see
+		/// 		Scene::setMaxRefractionDepth) or earlier by Russian roulette on their throughput.
+		/// 		With next event estimation, one point on the emissive triangles is sampled per bounce
+		/// 		and tested with a shadow ray; the emitted light is then only gathered by hits of the
+		/// 		primary and refracted rays, and by hits of analytic primitives (see Quadric), which
+		/// 		are not covered by the explicit samples.
+		/// 		Images converge with the number of samples per pixel.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	primary 	The nearest intersection of the primary ray.
+		/// \param	maxDepth	The maximum number of bounces (refractions excluded).
+		/// \param [in,out]	samples	The samples of the pixel.
+		///
+		/// \return	The color carried by the primary ray (one sample).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RGBColor tracePath(RayTriangleIntersection const & primary, int maxDepth, Math::SampleStream & samples)
+		{
+			RGBColor result ;
+			RGBColor throughput(1.0f, 1.0f, 1.0f) ;
+			RayTriangleIntersection intersection = primary ;
+			// Storage of the continuation rays (referenced by intersection)
+			Ray ray = *primary.ray() ;
+			bool emission = true ;
+			int depth = 0 ;
+			int refractionDepth = 0 ;
+			while(intersection.valid())
+			{
+				// Emissive analytic primitives are not sampled by next event estimation
+				if(emission || intersection.quadric()!=NULL) { result = result+throughput*emissiveColor(intersection) ; }
+				bool refractive = intersection.material()->refractionIndex()!=0 ;
+				if(refractive ? refractionDepth==m_maxRefractionDepth : depth==maxDepth) { break ; }
+
+				Math::Vector3 point = intersection.intersection() ;
+				uint32_t vertex = vertexDimension(depth+refractionDepth) ;
+				if(!refractive)
+				{
+					for(int light=0 ; light<(int)m_lights.size() ; ++light)
+					{
+						RGBColor contribution = pointLightColor(intersection, m_lights[light]) ;
+						if(contribution!=RGBColor() && !occluded(point, m_lights[light].position()))
+						{
+							result = result+throughput*contribution ;
+						}
+					}
+				}
+				Math::Vector3 target ;
+				RGBColor contribution ;
+				samples.setDimension(vertex+lightDimension) ;
+				if(m_nextEventEstimation && sampleEmissiveLight(intersection, samples, target, contribution) && !occluded(point, target))
+				{
+					result = result+throughput*contribution ;
+				}
+				Math::Vector3 direction ;
+				RGBColor weight ;
+				samples.setDimension(vertex+bounceDimension) ;
+				if(!sampleBounce(intersection, samples, direction, weight)) { break ; }
+				if(refractive) { ++refractionDepth ; } else { ++depth ; }
+				throughput = throughput*weight ;
+				float survival = survivalProbability(depth+refractionDepth, throughput) ;
+				if(survival<1.0f)
+				{
+					samples.setDimension(vertex+rouletteDimension) ;
+					if(samples.random()>=survival) { break ; }
+					throughput = throughput/survival ;
+				}
+				emission = !m_nextEventEstimation || refractive ;
+				ray = Ray(point, direction) ;
+				intersection = rayIntersection(ray) ;
+			}
+			return result ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::generateStage(TileScheduler::Tile const & tile, int pass, float xp,
+		/// 	float yp, RayQueue & queue)
+		///
+		/// \brief	Wavefront generation stage: pushes the primary rays of a tile, packet tile by packet
+		/// 		tile so that consecutive rays of the queue are coherent. Pixels are numbered in the
+		/// 		tile (line by line).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	tile		 	The tile.
+		/// \param	pass		 	The pass number (index of the samples).
+		/// \param	xp			 	The x offset of the sample in the pixels.
+		/// \param	yp			 	The y offset of the sample in the pixels.
+		/// \param [in,out]	queue	The queue receiving the rays.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void generateStage(TileScheduler::Tile const & tile, int pass, float xp, float yp, RayQueue & queue)
+		{
+			const int tileSize = PACKET_TILE_SIZE ;
+			::std::vector<Ray, aligned_allocator<Ray, 16> > rays ;
+			for(int tileY=0 ; tileY<tile.m_height ; tileY+=tileSize)
+			{
+				for(int tileX=0 ; tileX<tile.m_width ; tileX+=tileSize)
+				{
+					int columns = ::std::min(tileSize, tile.m_width-tileX) ;
+					int rows = ::std::min(tileSize, tile.m_height-tileY) ;
+					rays.clear() ;
+					primaryRays(tile.m_x+tileX, tile.m_y+tileY, columns, rows, pass, xp, yp, rays) ;
+					for(int cpt=0 ; cpt<(int)rays.size() ; ++cpt)
+					{
+						// Converged pixels (adaptive sampling) get no sample
+						if(!m_frameBuffer.active(tile.m_x+tileX+cpt%columns, tile.m_y+tileY+cpt/columns)) { continue ; }
+						int pixel = (tileY+cpt/columns)*tile.m_width+tileX+cpt%columns ;
+						queue.push(rays[cpt], RGBColor(1.0f, 1.0f, 1.0f), pixel, 0) ;
+					}
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::extendStage(RayQueue & queue)
+		///
+		/// \brief	Wavefront extension stage: computes the nearest intersection of all the rays of the
+		/// 		queue. Consecutive rays are traced as packets, incoherent packets fall back to single
+		/// 		ray traversals.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param [in,out]	queue	The queue.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void extendStage(RayQueue & queue)
+		{
+			const int packetSize = PACKET_TILE_SIZE*PACKET_TILE_SIZE ;
+			::std::vector<Ray, aligned_allocator<Ray, 16> > rays ;
+			for(int first=0 ; first<queue.size() ; first+=packetSize)
+			{
+				int count = ::std::min(packetSize, queue.size()-first) ;
+				rays.clear() ;
+				for(int cpt=0 ; cpt<count ; ++cpt)
+				{
+					rays.push_back(queue.ray(first+cpt)) ;
+				}
+				RayPacket<packetSize> packet(&rays[0], count) ;
+				rayIntersection(packet) ;
+				for(int cpt=0 ; cpt<count ; ++cpt)
+				{
+					queue.setIntersection(first+cpt, packet.intersection(cpt)) ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::shadeStage(TileScheduler::Tile const & tile, int pass,
+		/// 	RayQueue const & queue, RayQueue & next, ShadowQueue & shadows,
+		/// 	::std::vector<RGBColor> & radiance, int maxDepth)
+		///
+		/// \brief	Wavefront shading stage: adds the emitted light of the intersected surfaces, pushes
+		/// 		one shadow ray per point light and the continuation of the paths (see
+		/// 		Scene::sampleBounce).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	tile			   	The tile.
+		/// \param	pass			   	The pass number (index of the samples).
+		/// \param	queue			   	The queue of extended rays.
+		/// \param [in,out]	next	   	The queue receiving the continuations.
+		/// \param [in,out]	shadows	   	The queue receiving the shadow rays.
+		/// \param [in,out]	radiance   	The radiance of the pixels.
+		/// \param	maxDepth		   	The maximum depth.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void shadeStage(TileScheduler::Tile const & tile, int pass, RayQueue const & queue, RayQueue & next, ShadowQueue & shadows, ::std::vector<RGBColor> & radiance, int maxDepth)
+		{
+			for(int cpt=0 ; cpt<queue.size() ; ++cpt)
+			{
+				Ray ray = queue.ray(cpt) ;
+				RayTriangleIntersection intersection = queue.intersection(cpt, ray) ;
+				if(!intersection.valid()) { continue ; }
+				int pixel = queue.pixel(cpt) ;
+				int depth = queue.depth(cpt) ;
+				int refractionDepth = queue.refractionDepth(cpt) ;
+				RGBColor throughput = queue.throughput(cpt) ;
+				// Emissive analytic primitives are not sampled by next event estimation
+				if(queue.emission(cpt) || intersection.quadric()!=NULL) { radiance[pixel] = radiance[pixel]+throughput*emissiveColor(intersection) ; }
+				bool refractive = intersection.material()->refractionIndex()!=0 ;
+				if(refractive ? refractionDepth==m_maxRefractionDepth : depth==maxDepth) { continue ; }
+
+				Math::Vector3 point = intersection.intersection() ;
+				uint32_t vertex = vertexDimension(depth+refractionDepth) ;
+				Math::SampleStream samples(*m_sampler, (tile.m_y+pixel/tile.m_width)*m_visu->width()+tile.m_x+pixel%tile.m_width, pass) ;
+				if(!refractive)
+				{
+					for(int light=0 ; light<(int)m_lights.size() ; ++light)
+					{
+						RGBColor contribution = throughput*pointLightColor(intersection, m_lights[light]) ;
+						if(contribution!=RGBColor())
+						{
+							shadows.push(point, m_lights[light].position(), contribution, pixel) ;
+						}
+					}
+				}
+				Math::Vector3 target ;
+				RGBColor contribution ;
+				samples.setDimension(vertex+lightDimension) ;
+				if(m_nextEventEstimation && sampleEmissiveLight(intersection, samples, target, contribution))
+				{
+					shadows.push(point, target, throughput*contribution, pixel) ;
+				}
+				Math::Vector3 direction ;
+				RGBColor weight ;
+				samples.setDimension(vertex+bounceDimension) ;
+				if(!sampleBounce(intersection, samples, direction, weight)) { continue ; }
+				if(refractive) { ++refractionDepth ; } else { ++depth ; }
+				throughput = throughput*weight ;
+				float survival = survivalProbability(depth+refractionDepth, throughput) ;
+				if(survival<1.0f)
+				{
+					samples.setDimension(vertex+rouletteDimension) ;
+					if(samples.random()>=survival) { continue ; }
+					throughput = throughput/survival ;
+				}
+				next.push(Ray(point, direction), throughput, pixel, depth, refractionDepth, !m_nextEventEstimation || refractive) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::connectStage(ShadowQueue const & shadows, ::std::vector<RGBColor> & radiance)
+		///
+		/// \brief	Wavefront connection stage: traces the shadow rays (any hit queries) and adds the
+		/// 		contributions of the visible lights.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	shadows				The shadow rays.
+		/// \param [in,out]	radiance	The radiance of the pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void connectStage(ShadowQueue const & shadows, ::std::vector<RGBColor> & radiance)
+		{
+			for(int cpt=0 ; cpt<shadows.size() ; ++cpt)
+			{
+				if(!occluded(shadows.origin(cpt), shadows.target(cpt)))
+				{
+					int pixel = shadows.pixel(cpt) ;
+					radiance[pixel] = radiance[pixel]+shadows.contribution(cpt) ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::computeWavefrontTile(TileScheduler::Tile const & tile, int pass, float xp,
+		/// 	float yp, int maxDepth, WavefrontQueues & queues,
+		/// 	FrameBuffer & frameBuffer)
+		///
+		/// \brief	Renders one sample per pixel of a tile with the wavefront path tracer. All the paths of
+		/// 		the tile go through the generation, extension, shading and connection stages together,
+		/// 		stages exchanging the queues of the calling thread. Random numbers come from the
+		/// 		samples of the pixels (index: the pass number).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	tile					The tile.
+		/// \param	pass					The pass number.
+		/// \param	xp						The x offset of the sample in the pixels.
+		/// \param	yp						The y offset of the sample in the pixels.
+		/// \param	maxDepth				The maximum depth of the paths.
+		/// \param [in,out]	queues		The queues of the calling thread.
+		/// \param [in,out]	frameBuffer	The frame buffer accumulating the samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computeWavefrontTile(TileScheduler::Tile const & tile, int pass, float xp, float yp, int maxDepth, WavefrontQueues & queues, FrameBuffer & frameBuffer)
+		{
+			queues.m_radiance.assign(tile.m_width*tile.m_height, RGBColor()) ;
+			queues.m_queue.clear() ;
+			generateStage(tile, pass, xp, yp, queues.m_queue) ;
+			while(queues.m_queue.size()>0)
+			{
+				extendStage(queues.m_queue) ;
+				queues.m_next.clear() ;
+				queues.m_shadows.clear() ;
+				shadeStage(tile, pass, queues.m_queue, queues.m_next, queues.m_shadows, queues.m_radiance, maxDepth) ;
+				connectStage(queues.m_shadows, queues.m_radiance) ;
+				::std::swap(queues.m_queue, queues.m_next) ;
+			}
+			for(int pixel=0 ; pixel<(int)queues.m_radiance.size() ; ++pixel)
+			{
+				int x = tile.m_x+pixel%tile.m_width ;
+				int y = tile.m_y+pixel/tile.m_width ;
+				if(!frameBuffer.active(x, y)) { continue ; }
+				// Accumulation of the path tracing result in the associated pixel
+				frameBuffer.add(x, y, queues.m_radiance[pixel]*5) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::computeTile(TileScheduler::Tile const & tile, int pass, float xp, float yp,
+		/// 	int maxDepth, FrameBuffer & frameBuffer)
+		///
+		/// \brief	Renders one sample per pixel of a tile with the recursive ray tracer or the path
+		/// 		tracer. Primary rays are traced per packet tile (as packets if enabled).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	tile					The tile.
+		/// \param	pass					The pass number.
+		/// \param	xp						The x offset of the sample in the pixels.
+		/// \param	yp						The y offset of the sample in the pixels.
+		/// \param	maxDepth				The maximum depth.
+		/// \param [in,out]	frameBuffer	The frame buffer accumulating the samples.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computeTile(TileScheduler::Tile const & tile, int pass, float xp, float yp, int maxDepth, FrameBuffer & frameBuffer)
+		{
+			const int tileSize = PACKET_TILE_SIZE ;
+			::std::vector<Ray, aligned_allocator<Ray, 16> > rays ;
+			for(int tileY=tile.m_y ; tileY<tile.m_y+tile.m_height ; tileY+=tileSize)
+			{
+				for(int tileX=tile.m_x ; tileX<tile.m_x+tile.m_width ; tileX+=tileSize)
+				{
+					int columns = ::std::min(tileSize, tile.m_x+tile.m_width-tileX) ;
+					int rows = ::std::min(tileSize, tile.m_y+tile.m_height-tileY) ;
+					// Converged pixels (adaptive sampling) get no sample
+					if(!frameBuffer.active(tileX, tileY, columns, rows)) { continue ; }
+					rays.clear() ;
+					primaryRays(tileX, tileY, columns, rows, pass, xp, yp, rays) ;
+					// Ray casting
+					RayPacket<PACKET_TILE_SIZE*PACKET_TILE_SIZE> packet(&rays[0], (int)rays.size()) ;
+					if(m_primaryRayPackets)
+					{
+						rayIntersection(packet) ;
+					}
+					else
+					{
+						for(int cpt=0 ; cpt<(int)rays.size() ; ++cpt)
+						{
+							packet.set(cpt, rayIntersection(rays[cpt])) ;
+						}
+					}
+					for(int cpt=0 ; cpt<(int)rays.size() ; ++cpt)
+					{
+						int x = tileX+cpt%columns ;
+						int y = tileY+cpt/columns ;
+						if(!frameBuffer.active(x, y)) { continue ; }
+						// Samples of the pixel, indexed by the pass number
+						Math::SampleStream samples(*m_sampler, y*m_visu->width()+x, pass, vertexDimension(0)) ;
+						RGBColor result ;
+						if(m_renderMode==pathTracing)
+						{
+							result = tracePath(packet.intersection(cpt), maxDepth, samples)*5 ;
+						}
+						else
+						{
+							result = shade(packet.intersection(cpt), 0, maxDepth, samples)*5 ;
+						}
+						// Accumulation of ray casting result in the associated pixel
+						frameBuffer.add(x, y, result) ;
+					}
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::computeFeatures()
+		///
+		/// \brief	Computes the features of the denoiser: diffuse albedo, normal (oriented toward the
+		/// 		camera) and distance of the first hit of a ray through the center of each pixel.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void computeFeatures()
+		{
+			int width = m_visu->width() ;
+			int height = m_visu->height() ;
+			m_denoiser.resize(width, height) ;
+#pragma omp parallel for schedule(dynamic, 1)
+			for(int y=0 ; y<height ; ++y)
+			{
+				for(int x=0 ; x<width ; ++x)
+				{
+					Ray ray = m_camera.getRay((float)x/width, (float)y/height) ;
+					RayTriangleIntersection intersection = rayIntersection(ray) ;
+					if(!intersection.valid())
+					{
+						m_denoiser.setBackground(x, y) ;
+						continue ;
+					}
+					Math::Vector3 normal = intersection.normal() ;
+					if(normal*ray.direction()>0) { normal = normal*-1 ; }
+					m_denoiser.setFeatures(x, y, intersection.material()->diffuseColor(), normal, intersection.tRayValue()) ;
+				}
+			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::publish(TileScheduler::Tile const & tile)
+		///
+		/// \brief	Copies a tile of the frame buffer in the display buffer. Should be called by the
+		/// 		thread that rendered the tile, once the tile is finished.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	tile	The tile.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void publish(TileScheduler::Tile const & tile)
+		{
+#ifdef _OPENMP
+			omp_set_lock(&m_displayLock) ;
+#endif
+			m_displayBuffer.copy(m_frameBuffer, tile.m_x, tile.m_y, tile.m_width, tile.m_height) ;
+#ifdef _OPENMP
+			omp_unset_lock(&m_displayLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Scene::present(bool force)
+		///
+		/// \brief	Presents the display buffer in the rendering target if the presentation period is
+		/// 		elapsed since the last presentation. Only the snapshot of the display buffer is taken
+		/// 		under its lock, the rendering threads keep on rendering during the presentation.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	force	true to present whatever the date of the last presentation.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void present(bool force)
+		{
+			double now = currentTime() ;
+			if(force || (now-m_lastPresentation)*1000.0>=m_presentationPeriod)
+			{
+#ifdef _OPENMP
+				omp_set_lock(&m_displayLock) ;
+#endif
+				m_visu->snapshot(m_displayBuffer) ;
+#ifdef _OPENMP
+				omp_unset_lock(&m_displayLock) ;
+#endif
+				m_visu->presentSnapshot() ;
+				m_lastPresentation = now ;
+			}
+			// The target handles the input during the presentation
+			bool requested = m_visu->quitRequested() ;
+#ifdef _OPENMP
+			omp_set_lock(&m_displayLock) ;
+#endif
+			m_stopRequested = requested ;
+#ifdef _OPENMP
+			omp_unset_lock(&m_displayLock) ;
+#endif
+		}
 
-		// Calcul des ombres 
-		// Renvoie True si le triangle intersect est dans l'ombre, False sinon
-		bool shadow(Ray const & light, const Triangle * intersectionCamera)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Scene::stopRequested()
+		///
+		/// \brief	Tests if the user asked to stop the rendering. The request is read by the rendering
+		/// 		threads from the copy made by the presentation thread (see Scene::present), never
+		/// 		from the rendering target.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true to stop the rendering.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool stopRequested()
 		{
-			//On compare le point intersect par la lumire et par la camera
-			return !(rayIntersection(light).triangle() ==  intersectionCamera);
+#ifdef _OPENMP
+			omp_set_lock(&m_displayLock) ;
+#endif
+			bool requested = m_stopRequested ;
+#ifdef _OPENMP
+			omp_unset_lock(&m_displayLock) ;
+#endif
+			return requested ;
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static double Scene::currentTime()
+		///
+		/// \brief	Gets the current date, used to time the rendering and the presentations.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The date in seconds.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static double currentTime()
+		{
+#ifdef _OPENMP
+			return omp_get_wtime() ;
+#else
+			return (double)::std::clock()/CLOCKS_PER_SEC ;
+#endif
+		}
 
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static void Scene::pause(double duration)
+		///
+		/// \brief	Suspends the calling thread (the presentation thread, between two polls of the
+		/// 		rendering state).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	duration	The duration in seconds.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static void pause(double duration)
+		{
+#ifdef CPP11_OPT
+			::std::this_thread::sleep_for(::std::chrono::microseconds((long long)(duration*1e6))) ;
+#else
+			double end = currentTime()+duration ;
+			while(currentTime()<end) {}
+#endif
+		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	void Scene::compute(int maxDepth)
 		///
-		/// \brief	Computes a rendering of the current scene, viewed by the camera.
+		/// \brief	Computes a rendering of the current scene, viewed by the camera. The threads of a
+		/// 		single parallel region render all the passes, tiles being distributed by the tile
+		/// 		scheduler of the scene. If the target is interactive, the region has one more thread
+		/// 		than the rendering threads and its first thread does not render: it presents the
+		/// 		display buffer, where the rendering threads publish their finished tiles, in the
+		/// 		rendering target at a fixed rate (see Scene::setPresentationPeriod) and handles the
+		/// 		input, so that the rendering threads never access the target and the frame buffer is
+		/// 		never read while it is written. Non interactive targets are only presented at the end
+		/// 		of the rendering.
 		/// 		
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	04/12/2013
 		///
-		/// \param	maxDepth	The maximum recursive depth.
+		/// \param	maxDepth	The maximum recursive depth (refractions excluded, see
+		/// 					Scene::setMaxRefractionDepth).
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		void compute(int maxDepth)
 		{
 			// Number of samples per axis forone pixel. Number of samples per pixels = subPixelSubdivision^2
 			int subPixelDivision =  1 ; //50 ;//100 ;
+			// Acceleration structure
+			updateAccelerationStructure() ;
 			// Step on x and y forsubpixel sampling
 			float step = 1.0/subPixelDivision ;
-			// Table accumulating values computed per pixel (enable rendering of each pass)
-			::std::vector<::std::vector<::std::pair<int, RGBColor> > > pixelTable(m_visu->width(), ::std::vector<::std::pair<int, RGBColor> >(m_visu->width(), ::std::make_pair(0, RGBColor()))) ;
+			// Frame buffer accumulating the samples computed per pixel (enable rendering of each pass)
+			m_frameBuffer.resize(m_visu->width(), m_visu->height()) ;
+			m_displayBuffer.resize(m_visu->width(), m_visu->height()) ;
 
 			// 1 - Rendering time
-			LARGE_INTEGER frequency;        // ticks per second
-			LARGE_INTEGER t1, t2;           // ticks
-			double elapsedTime;
-			// get ticks per second
-			QueryPerformanceFrequency(&frequency);
-			// start timer
-			QueryPerformanceCounter(&t1);
-			// Rendering pass number
-			int pass = 0 ;
+			double t1 = currentTime() ;
+			// Number of rendering passes: a regular grid of subpixels for ray tracing, samples jittered
+			// per pixel by the sampler for path tracing
+			int passCount = subPixelDivision*subPixelDivision ;
+			if(m_renderMode!=recursiveRendering) { passCount = m_samplesPerPixel ; }
+			// Adaptive sampling: the budget of samples is shared by the pixels that did not converge
+			bool adaptive = m_renderMode!=recursiveRendering && m_adaptiveError>0.0f ;
+			if(adaptive) { passCount = ::std::max(m_samplesPerPixel, m_adaptiveMaxSamples) ; }
+			double sampleBudget = (double)m_samplesPerPixel*m_visu->width()*m_visu->height() ;
+			double sampleCount = 0.0 ;
+			int activePixels = m_visu->width()*m_visu->height() ;
+			// Offset of the current pass for ray tracing (shared by the threads)
+			float xp = 0.0f ;
+			float yp = 0.0f ;
+			// true if the user stopped the rendering (shared by the threads)
+			bool stopped = false ;
+			// Interactive targets are presented during the rendering by an additional thread
+			bool presenting = m_visu->interactive() ;
+			int threadCount = 1 ;
+#ifdef _OPENMP
+			threadCount = omp_get_max_threads()+(presenting ? 1 : 0) ;
+#endif
 			// Rendering
-			for(float xp=-0.5 ; xp<0.5 ; xp+=step)
+			present(true) ;
+#pragma omp parallel num_threads(threadCount)
 			{
-				for(float yp=-0.5 ; yp<0.5 ; yp+=step)
+				int thread = TileScheduler::threadIndex() ;
+				// The first thread presents the rendering (if other threads render)
+				bool presenterThread = presenting && TileScheduler::threadCount()>1 ;
+				bool presenter = presenterThread && thread==0 ;
+				int renderThread = presenterThread ? thread-1 : thread ;
+				int renderThreadCount = presenterThread ? TileScheduler::threadCount()-1 : TileScheduler::threadCount() ;
+				// Queues of the wavefront renderer (per thread)
+				WavefrontQueues queues ;
+				for(int pass=0 ; pass<passCount ; ++pass)
 				{
-					::std::cout<<"Pass: "<<pass<<::std::endl ;
-					++pass ;
-					// Sends primary rays foreach pixel (uncomment the pragma to parallelize rendering)
-#pragma omp parallel for//schedule(dynamic)
-					for(int y=0 ; y<m_visu->height() ; y++)
+#pragma omp single
+					{
+						stopped = stopRequested() ;
+						if(adaptive)
+						{
+							if(pass>=m_adaptiveMinSamples) { activePixels = m_frameBuffer.updateActivePixels(m_adaptiveError, m_adaptiveMinSamples) ; }
+							// The last pass only samples the remaining budget (pixels with the fewest samples first)
+							if(sampleCount+activePixels>sampleBudget) { activePixels = m_frameBuffer.limitActivePixels((int)(sampleBudget-sampleCount)) ; }
+							stopped = stopped || activePixels==0 ;
+							if(!stopped) { sampleCount += activePixels ; }
+						}
+						// The records of the previous pass are replaced by new estimates
+						if(m_irradianceCaching) { m_irradianceCache.clear() ; }
+						::std::cout<<"Pass: "<<pass<<::std::endl ;
+						xp = -0.5f+step*(pass/subPixelDivision) ;
+						yp = -0.5f+step*(pass%subPixelDivision) ;
+						m_scheduler.reset(m_visu->width(), m_visu->height(), renderThreadCount) ;
+					}
+					if(stopped) { break ; }
+					if(presenter)
+					{
+						while(!m_scheduler.passFinished() && !stopRequested())
+						{
+							present(false) ;
+							pause(0.001) ;
+						}
+					}
+					TileScheduler::Tile tile ;
+					while(!presenter && !stopRequested() && m_scheduler.next(renderThread, tile))
 					{
-						for(int x=0 ; x<m_visu->width() ; x++)
+						// Tiles whose pixels all converged (adaptive sampling) are skipped
+						if(m_frameBuffer.active(tile.m_x, tile.m_y, tile.m_width, tile.m_height))
 						{
-							//m_visu->plot(x,y,RGBColor(0.0,1.0,0.0)) ;
-							//m_visu->update() ;
-							// Ray casting
-							RGBColor result = sendRay(m_camera.getRay(((float)x+xp)/m_visu->width(), ((float)y+yp)/m_visu->height()), 0, maxDepth)*5 ;
-							// Accumulation of ray casting result in the associated pixel
-							::std::pair<int, RGBColor> & currentPixel = pixelTable[x][y] ;
-							currentPixel.first++ ;
-							currentPixel.second = currentPixel.second + result ;
-							// Pixel rendering (simple tone mapping)
-							m_visu->plot(x,y,pixelTable[x][y].second/pixelTable[x][y].first) ;
-							// Updates the rendering context (per pixel)
-							//m_visu->update();
+							if(m_renderMode==wavefrontPathTracing)
+							{
+								computeWavefrontTile(tile, pass, xp, yp, maxDepth, queues, m_frameBuffer) ;
+							}
+							else
+							{
+								computeTile(tile, pass, xp, yp, maxDepth, m_frameBuffer) ;
+							}
+							publish(tile) ;
 						}
-						// Updates the rendering context (per line)
-						m_visu->update();
+						m_scheduler.completed() ;
+						// Without presentation thread, an interactive target is presented between the tiles
+						if(presenting && !presenterThread) { present(false) ; }
 					}
-					// Updates the rendering context (per pass)
-					m_visu->update();
+#pragma omp barrier
 				}
 			}
+			if(m_denoising)
+			{
+				// Post pass: features of the first hits and filtering of the accumulated radiance
+				double denoisingStart = currentTime() ;
+				computeFeatures() ;
+				m_denoiser.denoise(m_frameBuffer) ;
+				::std::cout<<"denoising: "<<(currentTime()-denoisingStart)*1000.0<<"ms. "<<::std::endl ;
+				m_visu->present(m_denoiser.image()) ;
+			}
+			else
+			{
+				present(true) ;
+			}
 			// stop timer
-			QueryPerformanceCounter(&t2);
-			elapsedTime = (t2.QuadPart - t1.QuadPart) / frequency.QuadPart;
+			double elapsedTime = currentTime()-t1 ;
 			::std::cout<<"time: "<<elapsedTime<<"s. "<<::std::endl ;
 
 			cout << "Nombre de lances de rayons:" << count << endl;
+			if(adaptive)
+			{
+				::std::cout<<"Samples per pixel: "<<sampleCount/((double)m_visu->width()*m_visu->height())<<::std::endl ;
+			}
 
 		}
 	} ;
@@ -0,0 +1,399 @@
+#ifndef _Geometry_TileScheduler_H
+#define _Geometry_TileScheduler_H
+
+#include <vector>
+#include <algorithm>
+#include <Geometry/RayPacket.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef RENDER_TILE_SIZE
+/// \brief	The size (in pixels) of the square tiles distributed to the rendering threads. Should be a
+/// 		multiple of PACKET_TILE_SIZE.
+#define RENDER_TILE_SIZE (8*PACKET_TILE_SIZE)
+#endif
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	TileScheduler
+	///
+	/// \brief	Distributes the tiles of an image to the rendering threads. Tiles are ordered along a
+	/// 		Morton (Z-order) curve and each thread receives a contiguous range of this order, that
+	/// 		it processes from the front. A thread whose range is empty steals the tiles at the back
+	/// 		of the range of another thread, so that the threads stay busy until the end of the
+	/// 		pass whatever the cost of the tiles.
+	///
+	/// 		The scheduler is designed to be used from a parallel region that persists during all
+	/// 		the passes of a rendering: one thread calls TileScheduler::reset at the beginning of
+	/// 		each pass, then each thread calls TileScheduler::next until it returns false, and
+	/// 		TileScheduler::completed once each of its tiles is rendered.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class TileScheduler
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \struct	Tile
+		///
+		/// \brief	A rectangular tile of the image.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct Tile
+		{
+			/// \brief	The column of the first pixel.
+			int m_x ;
+			/// \brief	The line of the first pixel.
+			int m_y ;
+			/// \brief	The number of columns.
+			int m_width ;
+			/// \brief	The number of lines.
+			int m_height ;
+		} ;
+
+	protected:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \struct	ThreadTiles
+		///
+		/// \brief	The range of tiles of a thread, in the Morton order.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct ThreadTiles
+		{
+#ifdef _OPENMP
+			/// \brief	Protects the range (the owner and the thieves modify it).
+			omp_lock_t m_lock ;
+#endif
+			/// \brief	The first remaining tile.
+			int m_begin ;
+			/// \brief	The end of the range.
+			int m_end ;
+			/// \brief	Avoids false sharing between the ranges of two threads.
+			char m_padding[64] ;
+		} ;
+
+		/// \brief	The size of the tiles.
+		int m_tileSize ;
+		/// \brief	The width of the image.
+		int m_width ;
+		/// \brief	The height of the image.
+		int m_height ;
+		/// \brief	The tiles sorted along the Morton curve.
+		::std::vector<Tile> m_tiles ;
+		/// \brief	The range of tiles of each thread.
+		::std::vector<ThreadTiles> m_threads ;
+		/// \brief	The number of tiles of the pass that are not rendered yet.
+		int m_remaining ;
+#ifdef _OPENMP
+		/// \brief	Protects the number of remaining tiles.
+		omp_lock_t m_remainingLock ;
+#endif
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static unsigned int TileScheduler::mortonCode(unsigned int x, unsigned int y)
+		///
+		/// \brief	Computes the Morton code of 2D coordinates (interleaving of the bits).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The x coordinate (16 bits).
+		/// \param	y	The y coordinate (16 bits).
+		///
+		/// \return	The Morton code.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static unsigned int mortonCode(unsigned int x, unsigned int y)
+		{
+			unsigned int code = 0 ;
+			for(int bit=0 ; bit<16 ; ++bit)
+			{
+				code |= ((x>>bit)&1)<<(2*bit) ;
+				code |= ((y>>bit)&1)<<(2*bit+1) ;
+			}
+			return code ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void TileScheduler::buildTiles(int width, int height)
+		///
+		/// \brief	Cuts an image into tiles sorted along the Morton curve.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	width 	The width of the image.
+		/// \param	height	The height of the image.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void buildTiles(int width, int height)
+		{
+			m_width = width ;
+			m_height = height ;
+			::std::vector< ::std::pair<unsigned int, int> > codes ;
+			m_tiles.clear() ;
+			for(int y=0 ; y<height ; y+=m_tileSize)
+			{
+				for(int x=0 ; x<width ; x+=m_tileSize)
+				{
+					Tile tile = { x, y, ::std::min(m_tileSize, width-x), ::std::min(m_tileSize, height-y) } ;
+					codes.push_back(::std::make_pair(mortonCode(x/m_tileSize, y/m_tileSize), (int)m_tiles.size())) ;
+					m_tiles.push_back(tile) ;
+				}
+			}
+			::std::sort(codes.begin(), codes.end()) ;
+			::std::vector<Tile> sorted ;
+			sorted.reserve(m_tiles.size()) ;
+			for(int cpt=0 ; cpt<(int)codes.size() ; ++cpt)
+			{
+				sorted.push_back(m_tiles[codes[cpt].second]) ;
+			}
+			m_tiles.swap(sorted) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void TileScheduler::setThreadCount(int threadCount)
+		///
+		/// \brief	Allocates the ranges of the threads.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	threadCount	The number of threads.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setThreadCount(int threadCount)
+		{
+			destroyLocks() ;
+			m_threads.resize(threadCount) ;
+#ifdef _OPENMP
+			for(int cpt=0 ; cpt<threadCount ; ++cpt)
+			{
+				omp_init_lock(&m_threads[cpt].m_lock) ;
+			}
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void TileScheduler::destroyLocks()
+		///
+		/// \brief	Destroys the locks of the ranges of the threads.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void destroyLocks()
+		{
+#ifdef _OPENMP
+			for(int cpt=0 ; cpt<(int)m_threads.size() ; ++cpt)
+			{
+				omp_destroy_lock(&m_threads[cpt].m_lock) ;
+			}
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool TileScheduler::take(int thread, bool front, Tile & tile)
+		///
+		/// \brief	Takes a tile in the range of a thread.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	thread			The thread owning the range.
+		/// \param	front			true to take the first tile (owner), false to take the last one
+		/// 						(thief).
+		/// \param [out]	tile	The tile.
+		///
+		/// \return	false if the range is empty.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool take(int thread, bool front, Tile & tile)
+		{
+			ThreadTiles & tiles = m_threads[thread] ;
+			bool found = false ;
+#ifdef _OPENMP
+			omp_set_lock(&tiles.m_lock) ;
+#endif
+			if(tiles.m_begin<tiles.m_end)
+			{
+				tile = m_tiles[front ? tiles.m_begin++ : --tiles.m_end] ;
+				found = true ;
+			}
+#ifdef _OPENMP
+			omp_unset_lock(&tiles.m_lock) ;
+#endif
+			return found ;
+		}
+
+	private:
+		// The locks cannot be copied
+		TileScheduler(TileScheduler const &) ;
+		TileScheduler & operator=(TileScheduler const &) ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	TileScheduler::TileScheduler(int tileSize=RENDER_TILE_SIZE)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	tileSize	The size of the tiles.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TileScheduler(int tileSize=RENDER_TILE_SIZE)
+			: m_tileSize(tileSize), m_width(0), m_height(0), m_remaining(0)
+		{
+#ifdef _OPENMP
+			omp_init_lock(&m_remainingLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	TileScheduler::~TileScheduler()
+		///
+		/// \brief	Destructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		~TileScheduler()
+		{
+			destroyLocks() ;
+#ifdef _OPENMP
+			omp_destroy_lock(&m_remainingLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static int TileScheduler::threadIndex()
+		///
+		/// \brief	Gets the index of the calling thread in the current parallel region.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The index of the thread.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static int threadIndex()
+		{
+#ifdef _OPENMP
+			return omp_get_thread_num() ;
+#else
+			return 0 ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static int TileScheduler::threadCount()
+		///
+		/// \brief	Gets the number of threads of the current parallel region.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The number of threads.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static int threadCount()
+		{
+#ifdef _OPENMP
+			return omp_get_num_threads() ;
+#else
+			return 1 ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void TileScheduler::reset(int width, int height, int threadCount)
+		///
+		/// \brief	Starts a new pass: all the tiles of the image are distributed to the threads. Should
+		/// 		be called by a single thread while the others wait. Tiles and locks are kept as long as
+		/// 		the image size and the number of threads do not change.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	width	   	The width of the image.
+		/// \param	height	   	The height of the image.
+		/// \param	threadCount	The number of threads.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void reset(int width, int height, int threadCount)
+		{
+			if(width!=m_width || height!=m_height) { buildTiles(width, height) ; }
+			if(threadCount!=(int)m_threads.size()) { setThreadCount(threadCount) ; }
+			int tileCount = (int)m_tiles.size() ;
+			m_remaining = tileCount ;
+			for(int cpt=0 ; cpt<threadCount ; ++cpt)
+			{
+				m_threads[cpt].m_begin = (int)(((long long)tileCount*cpt)/threadCount) ;
+				m_threads[cpt].m_end = (int)(((long long)tileCount*(cpt+1))/threadCount) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool TileScheduler::next(int thread, Tile & tile)
+		///
+		/// \brief	Gets the next tile to render: the next tile of the range of the thread or, if this
+		/// 		range is empty, the last tile of another thread.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	thread			The index of the calling thread.
+		/// \param [out]	tile	The tile.
+		///
+		/// \return	false if all the tiles of the pass have been distributed.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool next(int thread, Tile & tile)
+		{
+			if(take(thread, true, tile)) { return true ; }
+			int threadCount = (int)m_threads.size() ;
+			for(int offset=1 ; offset<threadCount ; ++offset)
+			{
+				if(take((thread+offset)%threadCount, false, tile)) { return true ; }
+			}
+			return false ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void TileScheduler::completed()
+		///
+		/// \brief	Signals that a tile obtained with TileScheduler::next is rendered.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void completed()
+		{
+#ifdef _OPENMP
+			omp_set_lock(&m_remainingLock) ;
+#endif
+			--m_remaining ;
+#ifdef _OPENMP
+			omp_unset_lock(&m_remainingLock) ;
+#endif
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool TileScheduler::passFinished()
+		///
+		/// \brief	Tests if all the tiles of the pass are rendered.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if all the tiles are rendered.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool passFinished()
+		{
+#ifdef _OPENMP
+			omp_set_lock(&m_remainingLock) ;
+#endif
+			bool finished = m_remaining==0 ;
+#ifdef _OPENMP
+			omp_unset_lock(&m_remainingLock) ;
+#endif
+			return finished ;
+		}
+	} ;
+}
+
+#endif
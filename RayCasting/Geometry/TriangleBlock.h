@@ -0,0 +1,358 @@
+#ifndef _Geometry_TriangleBlock_H
+#define _Geometry_TriangleBlock_H
+
+#include <limits>
+#include <xmmintrin.h>
+#include <immintrin.h>
+#include <Geometry/Ray.h>
+#include <Geometry/Triangle.h>
+#include <System/CpuFeatures.h>
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	TriangleBlock
+	///
+	/// \brief	A block of Width triangles stored as structure of arrays (first vertex and the two
+	/// 		edges of each triangle, per axis) so that a ray is tested against the whole block with
+	/// 		a single SIMD kernel (see TriangleBlockTest). Unused slots have null edges and are never
+	/// 		intersected.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <int Width>
+	struct TriangleBlock
+	{
+		/// \brief	The first vertex of the triangles: m_vertex0[axis][triangle].
+		float m_vertex0[3][Width] ;
+		/// \brief	The first edge (vertex1-vertex0) of the triangles: m_edge1[axis][triangle].
+		float m_edge1[3][Width] ;
+		/// \brief	The second edge (vertex2-vertex0) of the triangles: m_edge2[axis][triangle].
+		float m_edge2[3][Width] ;
+		/// \brief	Index of the triangles in their geometry (-1 for an unused slot).
+		int m_triangle[Width] ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	TriangleBlock::TriangleBlock()
+		///
+		/// \brief	Default constructor. Initializes an empty block.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TriangleBlock()
+		{
+			for(int cpt=0 ; cpt<Width ; ++cpt)
+			{
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					m_vertex0[axis][cpt] = 0.0f ;
+					m_edge1[axis][cpt] = 0.0f ;
+					m_edge2[axis][cpt] = 0.0f ;
+				}
+				m_triangle[cpt] = -1 ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void TriangleBlock::set(int slot, Triangle const & triangle, int index)
+		///
+		/// \brief	Stores a triangle in a slot of the block.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	slot		The slot.
+		/// \param	triangle	The triangle (its u and v axes should be up to date).
+		/// \param	index   	The index of the triangle in its geometry.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void set(int slot, Triangle const & triangle, int index)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_vertex0[axis][slot] = triangle.vertex(0)[axis] ;
+				m_edge1[axis][slot] = triangle.uAxis()[axis] ;
+				m_edge2[axis][slot] = triangle.vAxis()[axis] ;
+			}
+			m_triangle[slot] = index ;
+		}
+	} ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	TriangleBlockTest
+	///
+	/// \brief	Mller-Trumbore intersection between one ray and the Width triangles of a block. The ray
+	/// 		is broadcast once, the tests (determinant, u, v, minimal distance) are the same as in
+	/// 		Triangle::intersection. The minimal distance can be changed for the rays transformed
+	/// 		in the frame of an instance (see Instance::intersection).
+	/// 		
+	/// 		The triangles are tested by 16 (AVX-512), 8 (AVX) or 4 (SSE), depending on the
+	/// 		instruction set selected at run time (see CpuFeatures).
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <int Width>
+	class TriangleBlockTest
+	{
+	protected:
+		/// \brief	The source of the ray, broadcast on each axis.
+		__m128 m_source[3] ;
+		/// \brief	The direction of the ray, broadcast on each axis.
+		__m128 m_direction[3] ;
+		/// \brief	The source of the ray (broadcast by the wider kernels).
+		float m_sourceCoordinates[3] ;
+		/// \brief	The direction of the ray (broadcast by the wider kernels).
+		float m_directionCoordinates[3] ;
+		/// \brief	The instruction set of the kernels.
+		CpuFeatures::InstructionSet m_instructionSet ;
+		/// \brief	The minimal distance of the intersections (self intersection threshold).
+		float m_tMin ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int TriangleBlockTest::intersect4(TriangleBlock<Width> const & block, int first,
+		/// 	float tMax, float * t, float * u, float * v) const
+		///
+		/// \brief	Intersects the ray with four consecutive triangles of the block (SSE).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	block	  	The block.
+		/// \param	first	  	The first triangle.
+		/// \param	tMax	  	The maximum distance on the ray.
+		/// \param [out]	t	The distances of the intersections.
+		/// \param [out]	u	The u coordinates of the intersections.
+		/// \param [out]	v	The v coordinates of the intersections.
+		///
+		/// \return	The mask of the intersected triangles.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int intersect4(TriangleBlock<Width> const & block, int first, float tMax, float * t, float * u, float * v) const
+		{
+			__m128 e1x = _mm_load_ps(block.m_edge1[0]+first), e1y = _mm_load_ps(block.m_edge1[1]+first), e1z = _mm_load_ps(block.m_edge1[2]+first) ;
+			__m128 e2x = _mm_load_ps(block.m_edge2[0]+first), e2y = _mm_load_ps(block.m_edge2[1]+first), e2z = _mm_load_ps(block.m_edge2[2]+first) ;
+			// pvec = direction ^ edge2
+			__m128 px = _mm_sub_ps(_mm_mul_ps(m_direction[1], e2z), _mm_mul_ps(m_direction[2], e2y)) ;
+			__m128 py = _mm_sub_ps(_mm_mul_ps(m_direction[2], e2x), _mm_mul_ps(m_direction[0], e2z)) ;
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(m_direction[0], e2y), _mm_mul_ps(m_direction[1], e2x)) ;
+			__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz)) ;
+			__m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det) ;
+			__m128 valid = _mm_cmpge_ps(absDet, _mm_set1_ps(0.000000001f)) ;
+			__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det) ;
+			// tvec = source - vertex0
+			__m128 tx = _mm_sub_ps(m_source[0], _mm_load_ps(block.m_vertex0[0]+first)) ;
+			__m128 ty = _mm_sub_ps(m_source[1], _mm_load_ps(block.m_vertex0[1]+first)) ;
+			__m128 tz = _mm_sub_ps(m_source[2], _mm_load_ps(block.m_vertex0[2]+first)) ;
+			__m128 uu = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet) ;
+			valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(uu, _mm_setzero_ps()), _mm_cmple_ps(uu, _mm_set1_ps(1.0f)))) ;
+			// qvec = tvec ^ edge1
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y)) ;
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z)) ;
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x)) ;
+			__m128 vv = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m_direction[0], qx), _mm_mul_ps(m_direction[1], qy)), _mm_mul_ps(m_direction[2], qz)), invDet) ;
+			valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(vv, _mm_setzero_ps()), _mm_cmple_ps(_mm_add_ps(uu, vv), _mm_set1_ps(1.0f)))) ;
+			__m128 tt = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet) ;
+			valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(tt, _mm_set1_ps(m_tMin)), _mm_cmplt_ps(tt, _mm_set1_ps(tMax)))) ;
+			_mm_storeu_ps(t, tt) ;
+			_mm_storeu_ps(u, uu) ;
+			_mm_storeu_ps(v, vv) ;
+			return _mm_movemask_ps(valid) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int TriangleBlockTest::intersect8(TriangleBlock<Width> const & block, int first,
+		/// 	float tMax, float * t, float * u, float * v) const
+		///
+		/// \brief	Intersects the ray with eight consecutive triangles of the block (AVX).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	block	  	The block.
+		/// \param	first	  	The first triangle.
+		/// \param	tMax	  	The maximum distance on the ray.
+		/// \param [out]	t	The distances of the intersections.
+		/// \param [out]	u	The u coordinates of the intersections.
+		/// \param [out]	v	The v coordinates of the intersections.
+		///
+		/// \return	The mask of the intersected triangles.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TARGET_AVX int intersect8(TriangleBlock<Width> const & block, int first, float tMax, float * t, float * u, float * v) const
+		{
+			__m256 direction[3] = { _mm256_set1_ps(m_directionCoordinates[0]), _mm256_set1_ps(m_directionCoordinates[1]), _mm256_set1_ps(m_directionCoordinates[2]) } ;
+			__m256 source[3] = { _mm256_set1_ps(m_sourceCoordinates[0]), _mm256_set1_ps(m_sourceCoordinates[1]), _mm256_set1_ps(m_sourceCoordinates[2]) } ;
+			__m256 e1x = _mm256_load_ps(block.m_edge1[0]+first), e1y = _mm256_load_ps(block.m_edge1[1]+first), e1z = _mm256_load_ps(block.m_edge1[2]+first) ;
+			__m256 e2x = _mm256_load_ps(block.m_edge2[0]+first), e2y = _mm256_load_ps(block.m_edge2[1]+first), e2z = _mm256_load_ps(block.m_edge2[2]+first) ;
+			// pvec = direction ^ edge2
+			__m256 px = _mm256_sub_ps(_mm256_mul_ps(direction[1], e2z), _mm256_mul_ps(direction[2], e2y)) ;
+			__m256 py = _mm256_sub_ps(_mm256_mul_ps(direction[2], e2x), _mm256_mul_ps(direction[0], e2z)) ;
+			__m256 pz = _mm256_sub_ps(_mm256_mul_ps(direction[0], e2y), _mm256_mul_ps(direction[1], e2x)) ;
+			__m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz)) ;
+			__m256 absDet = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), det) ;
+			__m256 valid = _mm256_cmp_ps(absDet, _mm256_set1_ps(0.000000001f), _CMP_GE_OQ) ;
+			__m256 invDet = _mm256_div_ps(_mm256_set1_ps(1.0f), det) ;
+			// tvec = source - vertex0
+			__m256 tx = _mm256_sub_ps(source[0], _mm256_load_ps(block.m_vertex0[0]+first)) ;
+			__m256 ty = _mm256_sub_ps(source[1], _mm256_load_ps(block.m_vertex0[1]+first)) ;
+			__m256 tz = _mm256_sub_ps(source[2], _mm256_load_ps(block.m_vertex0[2]+first)) ;
+			__m256 uu = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, px), _mm256_mul_ps(ty, py)), _mm256_mul_ps(tz, pz)), invDet) ;
+			valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(uu, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(uu, _mm256_set1_ps(1.0f), _CMP_LE_OQ))) ;
+			// qvec = tvec ^ edge1
+			__m256 qx = _mm256_sub_ps(_mm256_mul_ps(ty, e1z), _mm256_mul_ps(tz, e1y)) ;
+			__m256 qy = _mm256_sub_ps(_mm256_mul_ps(tz, e1x), _mm256_mul_ps(tx, e1z)) ;
+			__m256 qz = _mm256_sub_ps(_mm256_mul_ps(tx, e1y), _mm256_mul_ps(ty, e1x)) ;
+			__m256 vv = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(direction[0], qx), _mm256_mul_ps(direction[1], qy)), _mm256_mul_ps(direction[2], qz)), invDet) ;
+			valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(vv, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(uu, vv), _mm256_set1_ps(1.0f), _CMP_LE_OQ))) ;
+			__m256 tt = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet) ;
+			valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(tt, _mm256_set1_ps(m_tMin), _CMP_GE_OQ), _mm256_cmp_ps(tt, _mm256_set1_ps(tMax), _CMP_LT_OQ))) ;
+			_mm256_storeu_ps(t, tt) ;
+			_mm256_storeu_ps(u, uu) ;
+			_mm256_storeu_ps(v, vv) ;
+			return _mm256_movemask_ps(valid) ;
+		}
+
+#ifdef AVX512_KERNELS
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int TriangleBlockTest::intersect16(TriangleBlock<Width> const & block, int first,
+		/// 	float tMax, float * t, float * u, float * v) const
+		///
+		/// \brief	Intersects the ray with sixteen consecutive triangles of the block (AVX-512).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	block	  	The block.
+		/// \param	first	  	The first triangle.
+		/// \param	tMax	  	The maximum distance on the ray.
+		/// \param [out]	t	The distances of the intersections.
+		/// \param [out]	u	The u coordinates of the intersections.
+		/// \param [out]	v	The v coordinates of the intersections.
+		///
+		/// \return	The mask of the intersected triangles.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TARGET_AVX512 int intersect16(TriangleBlock<Width> const & block, int first, float tMax, float * t, float * u, float * v) const
+		{
+			__m512 direction[3] = { _mm512_set1_ps(m_directionCoordinates[0]), _mm512_set1_ps(m_directionCoordinates[1]), _mm512_set1_ps(m_directionCoordinates[2]) } ;
+			__m512 source[3] = { _mm512_set1_ps(m_sourceCoordinates[0]), _mm512_set1_ps(m_sourceCoordinates[1]), _mm512_set1_ps(m_sourceCoordinates[2]) } ;
+			__m512 e1x = _mm512_load_ps(block.m_edge1[0]+first), e1y = _mm512_load_ps(block.m_edge1[1]+first), e1z = _mm512_load_ps(block.m_edge1[2]+first) ;
+			__m512 e2x = _mm512_load_ps(block.m_edge2[0]+first), e2y = _mm512_load_ps(block.m_edge2[1]+first), e2z = _mm512_load_ps(block.m_edge2[2]+first) ;
+			// pvec = direction ^ edge2
+			__m512 px = _mm512_sub_ps(_mm512_mul_ps(direction[1], e2z), _mm512_mul_ps(direction[2], e2y)) ;
+			__m512 py = _mm512_sub_ps(_mm512_mul_ps(direction[2], e2x), _mm512_mul_ps(direction[0], e2z)) ;
+			__m512 pz = _mm512_sub_ps(_mm512_mul_ps(direction[0], e2y), _mm512_mul_ps(direction[1], e2x)) ;
+			__m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e1x, px), _mm512_mul_ps(e1y, py)), _mm512_mul_ps(e1z, pz)) ;
+			__mmask16 valid = _mm512_cmp_ps_mask(_mm512_abs_ps(det), _mm512_set1_ps(0.000000001f), _CMP_GE_OQ) ;
+			__m512 invDet = _mm512_div_ps(_mm512_set1_ps(1.0f), det) ;
+			// tvec = source - vertex0
+			__m512 tx = _mm512_sub_ps(source[0], _mm512_load_ps(block.m_vertex0[0]+first)) ;
+			__m512 ty = _mm512_sub_ps(source[1], _mm512_load_ps(block.m_vertex0[1]+first)) ;
+			__m512 tz = _mm512_sub_ps(source[2], _mm512_load_ps(block.m_vertex0[2]+first)) ;
+			__m512 uu = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(tx, px), _mm512_mul_ps(ty, py)), _mm512_mul_ps(tz, pz)), invDet) ;
+			valid &= _mm512_cmp_ps_mask(uu, _mm512_setzero_ps(), _CMP_GE_OQ) & _mm512_cmp_ps_mask(uu, _mm512_set1_ps(1.0f), _CMP_LE_OQ) ;
+			// qvec = tvec ^ edge1
+			__m512 qx = _mm512_sub_ps(_mm512_mul_ps(ty, e1z), _mm512_mul_ps(tz, e1y)) ;
+			__m512 qy = _mm512_sub_ps(_mm512_mul_ps(tz, e1x), _mm512_mul_ps(tx, e1z)) ;
+			__m512 qz = _mm512_sub_ps(_mm512_mul_ps(tx, e1y), _mm512_mul_ps(ty, e1x)) ;
+			__m512 vv = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(direction[0], qx), _mm512_mul_ps(direction[1], qy)), _mm512_mul_ps(direction[2], qz)), invDet) ;
+			valid &= _mm512_cmp_ps_mask(vv, _mm512_setzero_ps(), _CMP_GE_OQ) & _mm512_cmp_ps_mask(_mm512_add_ps(uu, vv), _mm512_set1_ps(1.0f), _CMP_LE_OQ) ;
+			__m512 tt = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e2x, qx), _mm512_mul_ps(e2y, qy)), _mm512_mul_ps(e2z, qz)), invDet) ;
+			valid &= _mm512_cmp_ps_mask(tt, _mm512_set1_ps(m_tMin), _CMP_GE_OQ) & _mm512_cmp_ps_mask(tt, _mm512_set1_ps(tMax), _CMP_LT_OQ) ;
+			_mm512_storeu_ps(t, tt) ;
+			_mm512_storeu_ps(u, uu) ;
+			_mm512_storeu_ps(v, vv) ;
+			return valid ;
+		}
+#endif
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	TriangleBlockTest::TriangleBlockTest(Ray const & ray,
+		/// 	CpuFeatures::InstructionSet instructionSet, float tMin=0.0001f)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray			  	The ray.
+		/// \param	instructionSet	The instruction set of the kernels (CpuFeatures::instructionSet,
+		/// 						read once per traversal).
+		/// \param	tMin		  	The minimal distance of the intersections.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TriangleBlockTest(Ray const & ray, CpuFeatures::InstructionSet instructionSet, float tMin=0.0001f)
+			: m_instructionSet(instructionSet), m_tMin(tMin)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_source[axis] = _mm_set1_ps(ray.source()[axis]) ;
+				m_direction[axis] = _mm_set1_ps(ray.direction()[axis]) ;
+				m_sourceCoordinates[axis] = ray.source()[axis] ;
+				m_directionCoordinates[axis] = ray.direction()[axis] ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int TriangleBlockTest::intersect(TriangleBlock<Width> const & block, float & tMax,
+		/// 	float & u, float & v) const
+		///
+		/// \brief	Computes the nearest intersection between the ray and the triangles of the block.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	block		  	The block.
+		/// \param [in,out]	tMax	The maximum distance on the ray, updated with the distance of the
+		/// 						nearest intersection.
+		/// \param [out]	u   	The u coordinate of the nearest intersection.
+		/// \param [out]	v   	The v coordinate of the nearest intersection.
+		///
+		/// \return	The index (in the geometry) of the nearest intersected triangle, -1 if no triangle
+		/// 		is intersected nearer than tMax.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int intersect(TriangleBlock<Width> const & block, float & tMax, float & u, float & v) const
+		{
+			float t[Width], uValues[Width], vValues[Width] ;
+			int mask = 0 ;
+			int first = 0 ;
+			// The widest kernels first, the remaining triangles with the narrower ones
+#ifdef AVX512_KERNELS
+			if(m_instructionSet>=CpuFeatures::avx512)
+			{
+				for( ; first+16<=Width ; first+=16)
+				{
+					mask |= intersect16(block, first, tMax, t+first, uValues+first, vValues+first) << first ;
+				}
+			}
+#endif
+			if(m_instructionSet>=CpuFeatures::avx)
+			{
+				for( ; first+8<=Width ; first+=8)
+				{
+					mask |= intersect8(block, first, tMax, t+first, uValues+first, vValues+first) << first ;
+				}
+			}
+			for( ; first<Width ; first+=4)
+			{
+				mask |= intersect4(block, first, tMax, t+first, uValues+first, vValues+first) << first ;
+			}
+			int nearest = -1 ;
+			for( ; mask!=0 ; mask &= mask-1)
+			{
+				int slot = 0 ;
+				while(!(mask & (1<<slot))) { ++slot ; }
+				if(t[slot]<tMax)
+				{
+					tMax = t[slot] ;
+					nearest = slot ;
+				}
+			}
+			if(nearest<0) { return -1 ; }
+			u = uValues[nearest] ;
+			v = vValues[nearest] ;
+			return block.m_triangle[nearest] ;
+		}
+	} ;
+}
+
+#endif
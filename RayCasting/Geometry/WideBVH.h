@@ -0,0 +1,786 @@
+#ifndef _Geometry_WideBVH_H
+#define _Geometry_WideBVH_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <assert.h>
+#include <xmmintrin.h>
+#include <immintrin.h>
+#include <Geometry/Ray.h>
+#include <Geometry/BoundingBox.h>
+#include <Geometry/BVH.h>
+#include <Geometry/RayPacket.h>
+#include <System/aligned_allocator.h>
+#include <System/CpuFeatures.h>
+
+/// \brief	Number of children of the nodes of the wide bounding volume hierarchies (4, 8 or 16). The
+/// 		kernels are selected at run time: 8 children are tested by one AVX kernel or by two SSE
+/// 		ones. Can be overridden in the project settings (16 for AVX-512 machines).
+#ifndef BVH_WIDTH
+#define BVH_WIDTH 8
+#endif
+
+namespace Geometry
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	WideBoxTest
+	///
+	/// \brief	SIMD intersection between a ray and the Width children boxes of a wide node. The ray
+	/// 		data (source, inverse direction) is broadcast once per traversal. The children bounds are
+	/// 		stored as structure of arrays: bounds[min / max][axis][child].
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <int Width>
+	class WideBoxTest
+	{
+	protected:
+		/// \brief	The source of the ray, broadcast on each axis.
+		__m128 m_source[3] ;
+		/// \brief	The inverse direction of the ray, broadcast on each axis.
+		__m128 m_invDirection[3] ;
+		/// \brief	The source of the ray (broadcast by the wider kernels).
+		float m_sourceCoordinates[3] ;
+		/// \brief	The inverse direction of the ray (broadcast by the wider kernels).
+		float m_invDirectionCoordinates[3] ;
+		/// \brief	The sign of the inverse direction (selects the near / far bound on each axis).
+		const int * m_sign ;
+		/// \brief	The instruction set of the kernels.
+		CpuFeatures::InstructionSet m_instructionSet ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int WideBoxTest::intersect4(const float (&bounds)[2][3][Width], int first, float tMax,
+		/// 	float * tEntry) const
+		///
+		/// \brief	Intersects the ray with four consecutive boxes (SSE).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	bounds		  	The bounds of the boxes.
+		/// \param	first		  	The first box.
+		/// \param	tMax		  	The maximum distance on the ray.
+		/// \param [out]	tEntry	The entry distances in the boxes.
+		///
+		/// \return	The mask of the intersected boxes.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int intersect4(const float (&bounds)[2][3][Width], int first, float tMax, float * tEntry) const
+		{
+			__m128 tNear = _mm_setzero_ps() ;
+			__m128 tFar = _mm_set1_ps(tMax) ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				__m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bounds[m_sign[axis]][axis]+first), m_source[axis]), m_invDirection[axis]) ;
+				__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(bounds[1-m_sign[axis]][axis]+first), m_source[axis]), m_invDirection[axis]) ;
+				// The running bound is the second operand: NaN (0*inf) slabs are ignored
+				tNear = _mm_max_ps(t0, tNear) ;
+				tFar = _mm_min_ps(t1, tFar) ;
+			}
+			_mm_storeu_ps(tEntry, tNear) ;
+			return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int WideBoxTest::intersect8(const float (&bounds)[2][3][Width], int first, float tMax,
+		/// 	float * tEntry) const
+		///
+		/// \brief	Intersects the ray with eight consecutive boxes (AVX).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	bounds		  	The bounds of the boxes.
+		/// \param	first		  	The first box.
+		/// \param	tMax		  	The maximum distance on the ray.
+		/// \param [out]	tEntry	The entry distances in the boxes.
+		///
+		/// \return	The mask of the intersected boxes.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TARGET_AVX int intersect8(const float (&bounds)[2][3][Width], int first, float tMax, float * tEntry) const
+		{
+			__m256 tNear = _mm256_setzero_ps() ;
+			__m256 tFar = _mm256_set1_ps(tMax) ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				__m256 source = _mm256_set1_ps(m_sourceCoordinates[axis]) ;
+				__m256 invDirection = _mm256_set1_ps(m_invDirectionCoordinates[axis]) ;
+				__m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(bounds[m_sign[axis]][axis]+first), source), invDirection) ;
+				__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(bounds[1-m_sign[axis]][axis]+first), source), invDirection) ;
+				tNear = _mm256_max_ps(t0, tNear) ;
+				tFar = _mm256_min_ps(t1, tFar) ;
+			}
+			_mm256_storeu_ps(tEntry, tNear) ;
+			return _mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ)) ;
+		}
+
+#ifdef AVX512_KERNELS
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int WideBoxTest::intersect16(const float (&bounds)[2][3][Width], int first, float tMax,
+		/// 	float * tEntry) const
+		///
+		/// \brief	Intersects the ray with sixteen consecutive boxes (AVX-512).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	bounds		  	The bounds of the boxes.
+		/// \param	first		  	The first box.
+		/// \param	tMax		  	The maximum distance on the ray.
+		/// \param [out]	tEntry	The entry distances in the boxes.
+		///
+		/// \return	The mask of the intersected boxes.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		TARGET_AVX512 int intersect16(const float (&bounds)[2][3][Width], int first, float tMax, float * tEntry) const
+		{
+			__m512 tNear = _mm512_setzero_ps() ;
+			__m512 tFar = _mm512_set1_ps(tMax) ;
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				__m512 source = _mm512_set1_ps(m_sourceCoordinates[axis]) ;
+				__m512 invDirection = _mm512_set1_ps(m_invDirectionCoordinates[axis]) ;
+				__m512 t0 = _mm512_mul_ps(_mm512_sub_ps(_mm512_load_ps(bounds[m_sign[axis]][axis]+first), source), invDirection) ;
+				__m512 t1 = _mm512_mul_ps(_mm512_sub_ps(_mm512_load_ps(bounds[1-m_sign[axis]][axis]+first), source), invDirection) ;
+				tNear = _mm512_max_ps(t0, tNear) ;
+				tFar = _mm512_min_ps(t1, tFar) ;
+			}
+			_mm512_storeu_ps(tEntry, tNear) ;
+			return _mm512_cmp_ps_mask(tNear, tFar, _CMP_LE_OQ) ;
+		}
+#endif
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	WideBoxTest::WideBoxTest(Ray const & ray, CpuFeatures::InstructionSet instructionSet)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	ray			  	The ray.
+		/// \param	instructionSet	The instruction set of the kernels (CpuFeatures::instructionSet,
+		/// 						read once per traversal).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		WideBoxTest(Ray const & ray, CpuFeatures::InstructionSet instructionSet)
+			: m_sign(ray.getSign()), m_instructionSet(instructionSet)
+		{
+			for(int axis=0 ; axis<3 ; ++axis)
+			{
+				m_source[axis] = _mm_set1_ps(ray.source()[axis]) ;
+				m_invDirection[axis] = _mm_set1_ps(ray.invDirection()[axis]) ;
+				m_sourceCoordinates[axis] = ray.source()[axis] ;
+				m_invDirectionCoordinates[axis] = ray.invDirection()[axis] ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int WideBoxTest::intersect(const float (&bounds)[2][3][Width], float tMax,
+		/// 	float * tEntry) const
+		///
+		/// \brief	Intersects the ray with the Width boxes, by 16 (AVX-512), 8 (AVX) or 4 (SSE)
+		/// 		depending on the instruction set selected at run time (see CpuFeatures).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	bounds		  	The bounds of the boxes (aligned on Width floats).
+		/// \param	tMax		  	The maximum distance on the ray.
+		/// \param [out]	tEntry	The entry distances in the boxes.
+		///
+		/// \return	The mask of the intersected boxes (bit i set if box i is intersected).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int intersect(const float (&bounds)[2][3][Width], float tMax, float * tEntry) const
+		{
+			int mask = 0 ;
+			int first = 0 ;
+#ifdef AVX512_KERNELS
+			if(m_instructionSet>=CpuFeatures::avx512)
+			{
+				for( ; first+16<=Width ; first+=16)
+				{
+					mask |= intersect16(bounds, first, tMax, tEntry+first) << first ;
+				}
+			}
+#endif
+			if(m_instructionSet>=CpuFeatures::avx)
+			{
+				for( ; first+8<=Width ; first+=8)
+				{
+					mask |= intersect8(bounds, first, tMax, tEntry+first) << first ;
+				}
+			}
+			for( ; first<Width ; first+=4)
+			{
+				mask |= intersect4(bounds, first, tMax, tEntry+first) << first ;
+			}
+			return mask ;
+		}
+	} ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	WideBVH
+	///
+	/// \brief	A bounding volume hierarchy whose nodes have Width children (4, 8 or 16). The hierarchy is
+	/// 		obtained by collapsing a binary SAH hierarchy (see BVH). The bounds of the children of a
+	/// 		node are stored as structure of arrays so that all the children are tested against a
+	/// 		ray with a single SIMD kernel (see WideBoxTest). The interface is the same as BVH.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	template <int Width>
+	class WideBVH
+	{
+	public:
+		/// \brief	Maximum size of the traversal stack: the root, then Width-1 more entries per
+		/// 		interior level (the depth is bounded by BVH::maxDepth, collapsing does not increase it).
+		static const int stackSize = BVH::maxDepth*(Width-1)+1 ;
+		/// \brief	Alignment of the nodes (size of a SIMD register of Width floats).
+		static const int alignment = Width*sizeof(float) ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	Node
+		///
+		/// \brief	A node of the hierarchy. Each child slot is an interior node, a leaf (range of
+		/// 		primitives) or empty.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct Node
+		{
+			/// \brief	The bounds of the children: m_bounds[min / max][axis][child].
+			float m_bounds[2][3][Width] ;
+			/// \brief	Index of the child node (interior) or of the first primitive (leaf).
+			int m_child[Width] ;
+			/// \brief	Number of primitives of the leaf, 0 for an interior node, -1 for an empty slot.
+			int m_count[Width] ;
+		} ;
+
+	protected:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \class	StackEntry
+		///
+		/// \brief	An entry of the traversal stack.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		struct StackEntry
+		{
+			/// \brief	The node index or the first primitive of the leaf.
+			int m_index ;
+			/// \brief	The number of primitives of the leaf (0 for an interior node).
+			int m_count ;
+			/// \brief	The entry distance of the ray in the node.
+			float m_distance ;
+		} ;
+
+		/// \brief	The nodes (the root is the first one).
+		::std::vector<Node, aligned_allocator<Node, alignment> > m_nodes ;
+		/// \brief	The primitive indexes, referenced by the leaves.
+		::std::vector<int> m_primitives ;
+		/// \brief	The maximum number of primitives in a leaf.
+		int m_maxLeafSize ;
+		/// \brief	The cost of a node traversal (SAH).
+		float m_traversalCost ;
+		/// \brief	The cost of a primitive intersection (SAH).
+		float m_intersectionCost ;
+		/// \brief	Number of primitives intersected at once by the leaf intersector (SAH).
+		int m_blockSize ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int WideBVH::collapse(BVH const & binary, int binaryNode)
+		///
+		/// \brief	Creates the wide node corresponding to an interior node of the binary hierarchy. The
+		/// 		interior child with the largest surface is replaced by its children until Width
+		/// 		children are gathered.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	binary	  	The binary hierarchy.
+		/// \param	binaryNode	The interior node of the binary hierarchy.
+		///
+		/// \return	The index of the created node.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int collapse(BVH const & binary, int binaryNode)
+		{
+			const ::std::vector<BVH::Node, aligned_allocator<BVH::Node, 16> > & nodes = binary.getNodes() ;
+			int children[Width] ;
+			int count = 2 ;
+			children[0] = binaryNode+1 ;
+			children[1] = nodes[binaryNode].m_offset ;
+			while(count<Width)
+			{
+				int largest = -1 ;
+				float largestSurface = -1.0f ;
+				for(int cpt=0 ; cpt<count ; ++cpt)
+				{
+					const BVH::Node & child = nodes[children[cpt]] ;
+					if(child.m_count==0 && child.m_box.surface()>largestSurface)
+					{
+						largest = cpt ;
+						largestSurface = child.m_box.surface() ;
+					}
+				}
+				if(largest==-1) { break ; }
+				int opened = children[largest] ;
+				children[largest] = opened+1 ;
+				children[count++] = nodes[opened].m_offset ;
+			}
+
+			int nodeIndex = (int)m_nodes.size() ;
+			m_nodes.push_back(Node()) ;
+			for(int cpt=0 ; cpt<Width ; ++cpt)
+			{
+				BoundingBox box ;
+				int child = -1 ;
+				int primitiveCount = -1 ;
+				if(cpt<count)
+				{
+					const BVH::Node & binaryChild = nodes[children[cpt]] ;
+					box = binaryChild.m_box ;
+					primitiveCount = binaryChild.m_count ;
+					child = (primitiveCount>0) ? binaryChild.m_offset : collapse(binary, children[cpt]) ;
+				}
+				// m_nodes may have been reallocated by the recursive calls
+				Node & node = m_nodes[nodeIndex] ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					node.m_bounds[0][axis][cpt] = box.minVertex()[axis] ;
+					node.m_bounds[1][axis][cpt] = box.maxVertex()[axis] ;
+				}
+				node.m_child[cpt] = child ;
+				node.m_count[cpt] = primitiveCount ;
+			}
+			return nodeIndex ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void WideBVH::push(Node const & node, int mask, const float * tEntry, StackEntry * stack,
+		/// 	int & top) const
+		///
+		/// \brief	Pushes the intersected children of a node on the traversal stack, from the farthest to
+		/// 		the nearest one.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	node		   	The node.
+		/// \param	mask		   	The mask of the intersected children.
+		/// \param	tEntry		   	The entry distances in the children.
+		/// \param [in,out]	stack	The stack.
+		/// \param [in,out]	top  	The top of the stack.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void push(Node const & node, int mask, const float * tEntry, StackEntry * stack, int & top) const
+		{
+			int first = top ;
+			for(int cpt=0 ; cpt<Width ; ++cpt)
+			{
+				if(!(mask & (1<<cpt)) || node.m_count[cpt]<0) { continue ; }
+				int position = top++ ;
+				assert(top<=stackSize) ;
+				while(position>first && stack[position-1].m_distance<tEntry[cpt])
+				{
+					stack[position] = stack[position-1] ;
+					--position ;
+				}
+				stack[position].m_index = node.m_child[cpt] ;
+				stack[position].m_count = node.m_count[cpt] ;
+				stack[position].m_distance = tEntry[cpt] ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <bool anyHit, class LeafIntersector> bool WideBVH::traverse(Ray const & ray,
+		/// 	float & tMax, LeafIntersector & intersector,
+		/// 	CpuFeatures::InstructionSet instructionSet) const
+		///
+		/// \brief	Traversal shared by the nearest intersection and the any hit queries. The intersected
+		/// 		children of a node are visited front to back and skipped as soon as they are farther
+		/// 		than tMax.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	anyHit		   	true to stop at the first intersection found.
+		/// \tparam	LeafIntersector	See WideBVH::intersectLeaves.
+		/// \param	ray					The ray.
+		/// \param [in,out]	tMax		The maximum distance on the ray.
+		/// \param [in,out]	intersector	The leaf intersector.
+		/// \param	instructionSet		The instruction set of the box tests.
+		///
+		/// \return	true if an intersection has been found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <bool anyHit, class LeafIntersector>
+		bool traverse(Ray const & ray, float & tMax, LeafIntersector & intersector, CpuFeatures::InstructionSet instructionSet) const
+		{
+			if(m_nodes.empty()) { return false ; }
+			WideBoxTest<Width> boxTest(ray, instructionSet) ;
+			bool found = false ;
+			StackEntry stack[stackSize] ;
+			int top = 0 ;
+			stack[top].m_index = 0 ;
+			stack[top].m_count = 0 ;
+			stack[top].m_distance = 0.0f ;
+			++top ;
+			while(top>0)
+			{
+				const StackEntry entry = stack[--top] ;
+				if(entry.m_distance>tMax) { continue ; }
+				if(entry.m_count>0)
+				{
+					if(intersector(entry.m_index, entry.m_count, tMax))
+					{
+						if(anyHit) { return true ; }
+						found = true ;
+					}
+					continue ;
+				}
+				const Node & node = m_nodes[entry.m_index] ;
+				float tEntry[Width] ;
+				int mask = boxTest.intersect(node.m_bounds, tMax, tEntry) ;
+				push(node, mask, tEntry, stack, top) ;
+			}
+			return found ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	WideBVH::WideBVH(int maxLeafSize=4, float traversalCost=1.0f,
+		/// 	float intersectionCost=1.0f, int blockSize=1)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	maxLeafSize			The maximum number of primitives in a leaf.
+		/// \param	traversalCost   	The cost of a node traversal (SAH).
+		/// \param	intersectionCost	The cost of a primitive intersection (SAH), or of a block of
+		/// 							primitives if blockSize is greater than 1.
+		/// \param	blockSize			The number of primitives intersected at once (see TriangleBlock).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		WideBVH(int maxLeafSize=4, float traversalCost=1.0f, float intersectionCost=1.0f, int blockSize=1)
+			: m_maxLeafSize(maxLeafSize), m_traversalCost(traversalCost), m_intersectionCost(intersectionCost), m_blockSize(blockSize)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void WideBVH::build(const ::std::vector<BoundingBox, aligned_allocator<BoundingBox, 16> > & boxes)
+		///
+		/// \brief	Builds the hierarchy on the primitives described by their bounding boxes: a binary
+		/// 		hierarchy is built and collapsed.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	boxes	The bounding boxes of the primitives.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void build(const ::std::vector<BoundingBox, aligned_allocator<BoundingBox, 16> > & boxes)
+		{
+			m_nodes.clear() ;
+			BVH binary(m_maxLeafSize, m_traversalCost, m_intersectionCost, m_blockSize) ;
+			binary.build(boxes) ;
+			m_primitives = binary.getPrimitives() ;
+			if(binary.empty()) { return ; }
+			const BVH::Node & root = binary.getNodes()[0] ;
+			if(root.m_count>0)
+			{
+				// The root is a leaf: single child node
+				Node node ;
+				for(int cpt=0 ; cpt<Width ; ++cpt)
+				{
+					BoundingBox box = (cpt==0) ? root.m_box : BoundingBox() ;
+					for(int axis=0 ; axis<3 ; ++axis)
+					{
+						node.m_bounds[0][axis][cpt] = box.minVertex()[axis] ;
+						node.m_bounds[1][axis][cpt] = box.maxVertex()[axis] ;
+					}
+					node.m_child[cpt] = (cpt==0) ? root.m_offset : -1 ;
+					node.m_count[cpt] = (cpt==0) ? root.m_count : -1 ;
+				}
+				m_nodes.push_back(node) ;
+			}
+			else
+			{
+				collapse(binary, 0) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool WideBVH::empty() const
+		///
+		/// \brief	Tests if the hierarchy is empty.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if empty, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool empty() const
+		{ return m_nodes.empty() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::vector<Node, aligned_allocator<Node, alignment> > & WideBVH::getNodes() const
+		///
+		/// \brief	Gets the nodes of the hierarchy.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The nodes.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::vector<Node, aligned_allocator<Node, alignment> > & getNodes() const
+		{ return m_nodes ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const ::std::vector<int> & WideBVH::getPrimitives() const
+		///
+		/// \brief	Gets the primitive indexes referenced by the leaves.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The primitives.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const ::std::vector<int> & getPrimitives() const
+		{ return m_primitives ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LeafMapper> void WideBVH::mapLeaves(LeafMapper & mapper)
+		///
+		/// \brief	Replaces the first primitive index of each leaf by a value computed by the mapper.
+		/// 		This allows to store the primitives of the leaves in a dedicated layout (see
+		/// 		TriangleBlock), the leaves are then traversed with WideBVH::intersectLeaves.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafMapper	Functor with signature int (int first, int count) where first is the
+		/// 					index of the first primitive of the leaf in WideBVH::getPrimitives
+		/// 					and count the number of primitives.
+		/// \param [in,out]	mapper	The mapper.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LeafMapper>
+		void mapLeaves(LeafMapper & mapper)
+		{
+			for(auto it=m_nodes.begin(), end=m_nodes.end() ; it!=end ; ++it)
+			{
+				for(int cpt=0 ; cpt<Width ; ++cpt)
+				{
+					if(it->m_count[cpt]>0)
+					{
+						it->m_child[cpt] = mapper(it->m_child[cpt], it->m_count[cpt]) ;
+					}
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LeafIntersector> bool WideBVH::intersectLeaves(Ray const & ray,
+		/// 	float & tMax, LeafIntersector & intersector,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		///
+		/// \brief	Computes the nearest intersection between a ray and the leaves of the hierarchy.
+		/// 		The intersected children of a node are visited front to back and skipped as soon as
+		/// 		they are farther than the nearest intersection found so far.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Functor with signature bool (int leaf, int count, float & tMax)
+		/// 						where leaf is the first primitive of the leaf (or the value
+		/// 						given by WideBVH::mapLeaves) and count its number of primitives.
+		/// 						It returns true and updates tMax if a primitive is intersected
+		/// 						nearer than tMax.
+		/// \param	ray					The ray.
+		/// \param [in,out]	tMax		The maximum distance on the ray, updated with the nearest
+		/// 							intersection.
+		/// \param [in,out]	intersector	The leaf intersector.
+		/// \param	instructionSet		The instruction set of the box tests.
+		///
+		/// \return	true if an intersection has been found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LeafIntersector>
+		bool intersectLeaves(Ray const & ray, float & tMax, LeafIntersector & intersector, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		{
+			return traverse<false>(ray, tMax, intersector, instructionSet) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LeafIntersector> bool WideBVH::occludedLeaves(Ray const & ray,
+		/// 	float tMax, LeafIntersector & intersector,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		///
+		/// \brief	Tests if a leaf primitive intersects the ray nearer than tMax. The traversal stops at
+		/// 		the first intersection found (any hit query, used for shadow rays).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Same functor as in WideBVH::intersectLeaves.
+		/// \param	ray					The ray.
+		/// \param	tMax				The maximum distance on the ray.
+		/// \param [in,out]	intersector	The leaf intersector.
+		/// \param	instructionSet		The instruction set of the box tests.
+		///
+		/// \return	true if an intersection has been found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LeafIntersector>
+		bool occludedLeaves(Ray const & ray, float tMax, LeafIntersector & intersector, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		{
+			return traverse<true>(ray, tMax, intersector, instructionSet) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LeafIntersector> bool WideBVH::intersect(Ray const & ray, float & tMax,
+		/// 	LeafIntersector & intersector,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		///
+		/// \brief	Computes the nearest intersection between a ray and the primitives of the hierarchy
+		/// 		(leaves should not have been remapped by WideBVH::mapLeaves).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Functor with signature bool (int primitive, float & tMax). It
+		/// 						returns true and updates tMax if the primitive is intersected
+		/// 						nearer than tMax.
+		/// \param	ray					The ray.
+		/// \param [in,out]	tMax		The maximum distance on the ray, updated with the nearest
+		/// 							intersection.
+		/// \param [in,out]	intersector	The primitive intersector.
+		/// \param	instructionSet		The instruction set of the box tests.
+		///
+		/// \return	true if an intersection has been found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LeafIntersector>
+		bool intersect(Ray const & ray, float & tMax, LeafIntersector & intersector, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		{
+			auto leafIntersector = [&](int first, int count, float & tCurrent) -> bool
+			{
+				bool found = false ;
+				for(int cpt=first, end=first+count ; cpt<end ; ++cpt)
+				{
+					found |= intersector(m_primitives[cpt], tCurrent) ;
+				}
+				return found ;
+			} ;
+			return intersectLeaves(ray, tMax, leafIntersector, instructionSet) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <class LeafIntersector> bool WideBVH::occluded(Ray const & ray, float tMax,
+		/// 	LeafIntersector & intersector,
+		/// 	CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		///
+		/// \brief	Tests if a primitive intersects the ray nearer than tMax, the traversal stops at the
+		/// 		first intersection (leaves should not have been remapped by WideBVH::mapLeaves).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Functor with signature bool (int primitive, float & tMax)
+		/// 						returning true if the primitive is intersected nearer than tMax.
+		/// \param	ray					The ray.
+		/// \param	tMax				The maximum distance on the ray.
+		/// \param [in,out]	intersector	The primitive intersector.
+		/// \param	instructionSet		The instruction set of the box tests.
+		///
+		/// \return	true if an intersection has been found, false otherwise.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <class LeafIntersector>
+		bool occluded(Ray const & ray, float tMax, LeafIntersector & intersector, CpuFeatures::InstructionSet instructionSet=CpuFeatures::instructionSet()) const
+		{
+			auto leafIntersector = [&](int first, int count, float & tCurrent) -> bool
+			{
+				for(int cpt=first, end=first+count ; cpt<end ; ++cpt)
+				{
+					if(intersector(m_primitives[cpt], tCurrent)) { return true ; }
+				}
+				return false ;
+			} ;
+			return occludedLeaves(ray, tMax, leafIntersector, instructionSet) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <int Size, class LeafIntersector> void WideBVH::intersectLeaves(
+		/// 	RayPacket<Size> & packet, LeafIntersector & intersector) const
+		///
+		/// \brief	Computes the nearest intersections between a coherent packet of rays and the leaves of
+		/// 		the hierarchy. Nodes are culled for the whole packet (see RayPacket::intersect) and
+		/// 		skipped when farther than the nearest intersections of all the rays.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Functor with signature void (int leaf, int count,
+		/// 						RayPacket<Size> & packet) updating the nearest intersections of
+		/// 						the packet (see WideBVH::intersectLeaves).
+		/// \param [in,out]	packet	   	The packet.
+		/// \param [in,out]	intersector	The leaf intersector.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <int Size, class LeafIntersector>
+		void intersectLeaves(RayPacket<Size> & packet, LeafIntersector & intersector) const
+		{
+			assert(packet.coherent()) ;
+			if(m_nodes.empty()) { return ; }
+			StackEntry stack[stackSize] ;
+			int top = 0 ;
+			stack[top].m_index = 0 ;
+			stack[top].m_count = 0 ;
+			stack[top].m_distance = 0.0f ;
+			++top ;
+			float tMax = packet.maxDistance() ;
+			while(top>0)
+			{
+				const StackEntry entry = stack[--top] ;
+				if(entry.m_distance>tMax) { continue ; }
+				if(entry.m_count>0)
+				{
+					intersector(entry.m_index, entry.m_count, packet) ;
+					tMax = packet.maxDistance() ;
+					continue ;
+				}
+				const Node & node = m_nodes[entry.m_index] ;
+				float tEntry[Width] ;
+				int mask = packet.intersect(node.m_bounds, tMax, tEntry) ;
+				push(node, mask, tEntry, stack, top) ;
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	template <int Size, class LeafIntersector> void WideBVH::intersect(
+		/// 	RayPacket<Size> & packet, LeafIntersector & intersector) const
+		///
+		/// \brief	Computes the nearest intersections between a coherent packet of rays and the
+		/// 		primitives of the hierarchy (leaves should not have been remapped).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \tparam	LeafIntersector	Functor with signature void (int primitive,
+		/// 						RayPacket<Size> & packet) updating the nearest intersections of
+		/// 						the packet.
+		/// \param [in,out]	packet	   	The packet.
+		/// \param [in,out]	intersector	The primitive intersector.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		template <int Size, class LeafIntersector>
+		void intersect(RayPacket<Size> & packet, LeafIntersector & intersector) const
+		{
+			auto leafIntersector = [&](int first, int count, RayPacket<Size> & current)
+			{
+				for(int cpt=first, end=first+count ; cpt<end ; ++cpt)
+				{
+					intersector(m_primitives[cpt], current) ;
+				}
+			} ;
+			intersectLeaves(packet, leafIntersector) ;
+		}
+	} ;
+}
+
+#endif
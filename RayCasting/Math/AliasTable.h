@@ -0,0 +1,126 @@
+#ifndef _Math_AliasTable_H
+#define _Math_AliasTable_H
+
+#include <vector>
+#include <algorithm>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	AliasTable
+	///
+	/// \brief	Samples a discrete distribution in constant time (Walker's alias method, built with
+	/// 		Vose's algorithm). Each entry stores the probability of keeping the entry and the index
+	/// 		of its alias.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class AliasTable
+	{
+	protected:
+		/// \brief	The probability of keeping each entry (the alias is chosen otherwise).
+		::std::vector<float> m_probability ;
+		/// \brief	The alias of each entry.
+		::std::vector<int> m_alias ;
+		/// \brief	The normalized weight (probability to be sampled) of each entry.
+		::std::vector<float> m_pdf ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void AliasTable::build(::std::vector<float> const & weights)
+		///
+		/// \brief	Builds the table of a distribution.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	weights	The (non negative, non normalized) weights of the entries.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void build(::std::vector<float> const & weights)
+		{
+			int size = (int)weights.size() ;
+			m_probability.assign(size, 1.0f) ;
+			m_alias.resize(size) ;
+			m_pdf.assign(size, 0.0f) ;
+			double total = 0.0 ;
+			for(int cpt=0 ; cpt<size ; ++cpt)
+			{
+				total += weights[cpt] ;
+				m_alias[cpt] = cpt ;
+			}
+			if(total<=0.0) { m_probability.clear() ; m_alias.clear() ; m_pdf.clear() ; return ; }
+
+			// Scaled probabilities: entries under 1 are completed by an alias over 1
+			::std::vector<double> scaled(size) ;
+			::std::vector<int> underfull, overfull ;
+			for(int cpt=0 ; cpt<size ; ++cpt)
+			{
+				m_pdf[cpt] = (float)(weights[cpt]/total) ;
+				scaled[cpt] = weights[cpt]*size/total ;
+				if(scaled[cpt]<1.0) { underfull.push_back(cpt) ; }
+				else { overfull.push_back(cpt) ; }
+			}
+			while(!underfull.empty() && !overfull.empty())
+			{
+				int less = underfull.back() ; underfull.pop_back() ;
+				int more = overfull.back() ;
+				m_probability[less] = (float)scaled[less] ;
+				m_alias[less] = more ;
+				scaled[more] -= 1.0-scaled[less] ;
+				if(scaled[more]<1.0) { overfull.pop_back() ; underfull.push_back(more) ; }
+			}
+			// Remaining entries (rounding errors) are kept with probability 1
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool AliasTable::empty() const
+		///
+		/// \brief	Tests if the distribution is empty (no entry or null weights).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if empty.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool empty() const
+		{ return m_alias.empty() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	int AliasTable::sample(float random) const
+		///
+		/// \brief	Samples an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	random	A uniform random number in [0;1[.
+		///
+		/// \return	The index of the entry.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		int sample(float random) const
+		{
+			int size = (int)m_alias.size() ;
+			float scaled = random*size ;
+			int index = ::std::min((int)scaled, size-1) ;
+			return (scaled-index<m_probability[index]) ? index : m_alias[index] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float AliasTable::pdf(int index) const
+		///
+		/// \brief	Gets the probability of sampling an entry.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	The index of the entry.
+		///
+		/// \return	The probability.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float pdf(int index) const
+		{ return m_pdf[index] ; }
+	} ;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef _Math_HaltonSampler_H
+#define _Math_HaltonSampler_H
+
+#include <Math/Sampler.h>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	HaltonSampler
+	///
+	/// \brief	Scrambled Halton samples: dimension d is the radical inverse of the sample index in
+	/// 		the base of the d-th prime number, each digit being shifted (modulo the base) by a value
+	/// 		hashed from the pixel, the dimension and the position of the digit. Dimensions beyond
+	/// 		the table of primes (where Halton samples are poorly distributed anyway) are pseudo
+	/// 		random.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class HaltonSampler : public Sampler
+	{
+	public:
+		/// \brief	The number of low discrepancy dimensions.
+		static const int dimensionCount = 32 ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static uint32_t HaltonSampler::prime(int dimension)
+		///
+		/// \brief	Gets the base of a dimension.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	dimension	The dimension (in [0;dimensionCount[).
+		///
+		/// \return	The prime number.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static uint32_t prime(int dimension)
+		{
+			static const uint32_t primes[dimensionCount] = {
+				2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+				59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131 } ;
+			return primes[dimension] ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual float HaltonSampler::sample(uint32_t pixel, uint32_t index,
+		/// 	uint32_t dimension) const
+		///
+		/// \brief	Computes a sample.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	pixel	 	The pixel.
+		/// \param	index	 	The index of the sample in the pixel.
+		/// \param	dimension	The dimension.
+		///
+		/// \return	The sample in [0;1[.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual float sample(uint32_t pixel, uint32_t index, uint32_t dimension) const
+		{
+			uint32_t seed = hash(pixel ^ hash(dimension)) ;
+			if(dimension>=(uint32_t)dimensionCount)
+			{
+				return toFloat(hash(seed ^ hash(index))) ;
+			}
+			uint32_t base = prime(dimension) ;
+			float inverseBase = 1.0f/base ;
+			float factor = inverseBase ;
+			float result = 0.0f ;
+			// Digits are scrambled until they fall below the float precision (shifted zeros included)
+			for(uint32_t digitIndex=0 ; factor>1.0f/16777216.0f ; ++digitIndex)
+			{
+				uint32_t digit = (index%base+hash(seed+digitIndex))%base ;
+				result += digit*factor ;
+				index /= base ;
+				factor *= inverseBase ;
+			}
+			// Rounding may reach 1
+			return result<1.0f ? result : 0.99999994f ;
+		}
+	} ;
+}
+
+#endif
@@ -1,22 +0,0 @@
-#ifndef _Object_H
-#define _Object_H
-
-namespace Math
-{
-  ////////////////////////////////////////////////////////////////////////////////////////////////////
-  /// \class	Object
-  ///
-  /// \brief	Super class of methematical objects.
-  ///
-  /// \author	F. Lamarche, Universit de Rennes 1
-  /// \date	03/12/2013
-  ////////////////////////////////////////////////////////////////////////////////////////////////////
-  class Object 
-  {
-  public:
-    virtual ~Object()
-    {}
-  } ;
-}
-
-#endif
@@ -2,19 +2,19 @@
 #define _Math_Quaternion_H
 
 #include <Math/Vector3.h>
-#include <Math/Object.h>
 
 namespace Math
 {
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   /// \class	Quaternion
   ///
-  /// \brief	A quaternion.
+  /// \brief	A quaternion. Standard layout and trivially copyable (no virtual method, implicit
+  /// 		copy).
   ///
   /// \author	F. Lamarche, Universit de Rennes 1
   /// \date	03/12/2013
   ////////////////////////////////////////////////////////////////////////////////////////////////////
-  class Quaternion : public Object
+  class Quaternion
   {
   protected:
     float   m_s ;
@@ -65,22 +65,11 @@ namespace Math
     ///
     /// \param	v	The point
     ////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef CPP11_OPT
+    constexpr
+#endif
     Quaternion(Vector3 const & v)
-      : m_s(0.0), m_v(v), m_angle(0.0), m_axis(v) 
-    {}
-
-    ////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \fn	Quaternion::Quaternion(Quaternion const & q)
-    ///
-    /// \brief	Copy constructor.
-    ///
-    /// \author	F. Lamarche, Universit de Rennes 1
-    /// \date	03/12/2013
-    ///
-    /// \param	q	The Quaternion const &amp; to process.
-    ////////////////////////////////////////////////////////////////////////////////////////////////////
-    Quaternion(Quaternion const & q)
-      : m_s(q.m_s), m_v(q.m_v), m_angle(q.m_angle), m_axis(q.m_axis)
+      : m_s(0.0f), m_v(v), m_angle(0.0f), m_axis(v) 
     {}
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,8 +83,11 @@ namespace Math
     /// \param	s	
     /// \param	v	
     ////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef CPP11_OPT
+    constexpr
+#endif
     Quaternion(float const & s, Vector3 const & v)
-      : m_s(s), m_v(v)
+      : m_s(s), m_v(v), m_angle(0.0f), m_axis(v)
     {}
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -284,25 +276,6 @@ namespace Math
     float norm() const
     {	return sqrt(this->norm2()) ; }
 
-    ////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \fn	Quaternion & Quaternion::operator= (Quaternion const & q)
-    ///
-    /// \brief	Assignment operator.
-    ///
-    /// \author	F. Lamarche, Universit de Rennes 1
-    /// \date	03/12/2013
-    ///
-    /// \param	q	The other quaternion.
-    ///
-    /// \return	A shallow copy of this object.
-    ////////////////////////////////////////////////////////////////////////////////////////////////////
-    Quaternion & operator= (Quaternion const & q)
-    {
-      m_s = q.m_s ;
-      m_v = q.m_v ;
-      return (*this) ;
-    }
-
     ////////////////////////////////////////////////////////////////////////////////////////////////////
     /// \fn	Quaternion & Quaternion::normalize()
     ///
@@ -336,6 +309,10 @@ namespace Math
       return (*this)*q*this->inv() ;
     }
   };
+
+#ifdef CPP11_OPT
+  static_assert(::std::is_standard_layout<Quaternion>::value && ::std::is_trivially_copyable<Quaternion>::value, "Math::Quaternion must be a POD-like type") ;
+#endif
 } 
 
 #endif
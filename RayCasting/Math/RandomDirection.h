@@ -3,6 +3,10 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <Math/Vector3.h>
+#include <Math/sse/Float4_approximations.h>
+#include <Math/Sampler.h>
 
 namespace Math
 {
@@ -11,7 +15,13 @@ namespace Math
 	///
 	/// \brief	Random direction sampling. the sampling is biased by a cosine distribution, useful for
 	/// 		respecting a BRDF distribution (diffuse or specular).
-	/// 		
+	///
+	/// 		The tangent frame of the main direction is built once by the constructor: directions
+	/// 		are generated in this frame without rotation. Directions can be generated by batches
+	/// 		(SSE, four directions per step), trigonometric, exponential and logarithm functions
+	/// 		being replaced by polynomial approximations. The probability density of the generated
+	/// 		directions is provided with them.
+	///
 	/// \author	F. Lamarche, University of Rennes 1.
 	/// \date	04/12/2013
 	////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -19,126 +29,227 @@ namespace Math
 	{
 	protected:
 
+		/// \brief	The main direction for sampling.
+		Math::Vector3 m_direction ;
+
+		/// \brief	A direction normal to the direction vector (first axis of the tangent frame).
+		Math::Vector3 m_tangent ;
+
+		/// \brief	The second axis of the tangent frame.
+		Math::Vector3 m_bitangent ;
+
+		/// \brief	The specular coefficient.
+		float m_n ;
+
+		/// \brief	The normalization factor of the cos^n distribution: (n+1)/(2pi).
+		float m_normalization ;
+
+	public:
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	static ::std::pair<float,float> RandomDirection::randomPolar(float n=1.0)
+		/// \fn	RandomDirection::RandomDirection(Math::Vector3 const & direction, float n=1.0)
 		///
-		/// \brief	Random sampling of spherical coordinates.
+		/// \brief	Constructor, computes the tangent frame of the main direction (branchless
+		/// 		orthonormal basis of T. Duff et al., JCGT 2017).
 		///
 		/// \author	F. Lamarche, University of Rennes 1.
 		/// \date	04/12/2013
 		///
-		/// \param	n	(optional) The specular index (1.0 if diffuse).
+		/// \param	direction	The main direction of the random sampling.
+		/// \param	n		 	n The specular coefficient of the surface (1.0 is diffuse component, the
+		/// 					specular coefficient otherwise)
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RandomDirection(Math::Vector3 const & direction, float n=1.0)
+			: m_direction(direction.normalized()), m_n(n), m_normalization((n+1.0f)/(2.0f*(float)M_PI))
+		{
+			float x = m_direction[0] ;
+			float y = m_direction[1] ;
+			float z = m_direction[2] ;
+			float sign = (z>=0.0f) ? 1.0f : -1.0f ;
+			float a = -1.0f/(sign+z) ;
+			float b = x*y*a ;
+			m_tangent = Math::Vector3(1.0f+sign*x*x*a, sign*b, -sign*x) ;
+			m_bitangent = Math::Vector3(b, sign+y*y*a, -y) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float RandomDirection::pdf(Math::Vector3 const & direction) const
+		///
+		/// \brief	Computes the probability density of a direction (per unit solid angle).
 		///
-		/// \return	Random spherical coordinates repecting a cos^n distribution.
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	direction	The (normalized) direction.
+		///
+		/// \return	The density, (n+1)/(2pi).cos^n of the angle to the main direction.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		static ::std::pair<float,float> randomPolar(float n=1.0)
+		float pdf(Math::Vector3 const & direction) const
 		{
-			float rand1 = random() ;
-			float p = pow(rand1, 1/(n+1)) ;
-			float theta = acos(p) ;
-			float rand2 = random() ;
-			float phy = 2*M_PI*rand2 ;
-			return ::std::make_pair(theta, phy) ;
+			float cosine = direction*m_direction ;
+			if(cosine<=0.0f) { return 0.0f ; }
+			return m_normalization*pow(cosine, m_n) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	static Math::Vector3 RandomDirection::getVector(float theta, float phy)
+		/// \fn	Math::Vector3 RandomDirection::generate(float u, float v, float & pdf) const
 		///
-		/// \brief	Computes the normalized vector corresponding to provided spherical coordinates.
-		/// 		
-		/// \author	F. Lamarche, University of Rennes 1.
-		/// \date	04/12/2013
+		/// \brief	Generates the direction associated with two uniform samples, respecting a cosine^n
+		/// 		distribution.
 		///
-		/// \param	theta	
-		/// \param	phy  	
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
 		///
-		/// \return	The vector.
+		/// \param	u		   	The sample of the angle to the main direction.
+		/// \param	v		   	The sample of the angle around the main direction.
+		/// \param [out]	pdf	The probability density of the direction.
+		///
+		/// \return	The direction.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		static Math::Vector3 getVector(float theta, float phy)
+		Math::Vector3 generate(float u, float v, float & pdf) const
 		{
-			return Math::Vector3(sin(theta)*cos(phy), sin(theta)*sin(phy), cos(theta)) ;
+			// cos(theta) = u^(1/(n+1)), the density is (n+1)/(2pi).u^(n/(n+1))
+			u = ::std::max(u, 1.0f/16777216.0f) ;
+			float logU = log(u) ;
+			float cosine = exp(logU/(m_n+1.0f)) ;
+			pdf = m_normalization*exp(logU*m_n/(m_n+1.0f)) ;
+			float sine = sqrt(::std::max(0.0f, 1.0f-cosine*cosine)) ;
+			float phi = 2.0f*(float)M_PI*v ;
+			return m_tangent*(sine*cos(phi))+m_bitangent*(sine*sin(phi))+m_direction*cosine ;
 		}
 
-	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Math::Vector3 RandomDirection::generate(SampleStream & samples, float & pdf) const
+		///
+		/// \brief	Generate a random direction respecting a cosine^n distribution.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param [in,out]	samples	The samples (two dimensions are used).
+		/// \param [out]	pdf		The probability density of the direction.
+		///
+		/// \return	The random direction.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Math::Vector3 generate(SampleStream & samples, float & pdf) const
+		{
+			float u = samples.random() ;
+			float v = samples.random() ;
+			return generate(u, v, pdf) ;
+		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	static float RandomDirection::random()
+		/// \fn	Math::Vector3 RandomDirection::generate(SampleStream & samples) const
 		///
-		/// \brief	A random value in interval [0;1]
+		/// \brief	Generate a random direction respecting a cosine^n distribution.
 		///
 		/// \author	F. Lamarche, University of Rennes 1.
 		/// \date	04/12/2013
 		///
-		/// \return	A random number in [0;1].
+		/// \param [in,out]	samples	The samples (two dimensions are used).
+		///
+		/// \return	The random direction.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		static float random()
+		Math::Vector3 generate(SampleStream & samples) const
 		{
-			return (float)rand()/RAND_MAX ;
+			float pdf ;
+			return generate(samples, pdf) ;
 		}
 
-	protected:
-
-		/// \brief	The main direction for sampling.
-		Math::Vector3 m_direction ;
-
-		/// \brief	A direction normal to the direction vector.
-		Math::Vector3 m_directionNormal ;
-
-		/// \brief	The specular coefficient.
-		float m_n ;
-
-	public:
-
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	RandomDirection::RandomDirection(Math::Vector3 const & direction, float n=1.0)
+		/// \fn	void RandomDirection::generate(float const * u, float const * v, int count,
+		/// 	Math::Vector3 * directions, float * pdf) const
 		///
-		/// \brief	Constructor.
+		/// \brief	Generates a batch of directions respecting a cosine^n distribution, four at a time
+		/// 		with SSE instructions and polynomial approximations of the transcendental functions.
 		///
-		/// \author	F. Lamarche, University of Rennes 1.
-		/// \date	04/12/2013
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
 		///
-		/// \param	direction	The main direction of the random sampling.
-		/// \param	n		 	n The specular coefficient of the surface (1.0 is diffuse component, the 
-		/// 					specular coefficient otherwise)
+		/// \param	u					The samples of the angles to the main direction.
+		/// \param	v					The samples of the angles around the main direction.
+		/// \param	count				The number of directions.
+		/// \param [out]	directions	The directions.
+		/// \param [out]	pdf		  	The probability densities of the directions.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		RandomDirection(Math::Vector3 const & direction, float n=1.0)
-			: m_direction(direction.normalized()), m_n(n)
+		void generate(float const * u, float const * v, int count, Math::Vector3 * directions, float * pdf) const
 		{
-			// We compute a vector normal to the main direction
-			m_directionNormal = Math::Vector3(1.0,0.0,0.0) ;
-			m_directionNormal = m_directionNormal - m_direction*(m_direction*m_directionNormal) ;
-			if(m_directionNormal.norm()<std::numeric_limits<float>::epsilon()*10.0)
+			const __m128 exponent = _mm_set1_ps(1.0f/(m_n+1.0f)) ;
+			const __m128 pdfExponent = _mm_set1_ps(m_n/(m_n+1.0f)) ;
+			const __m128 normalization = _mm_set1_ps(m_normalization) ;
+			const bool diffuse = m_n==1.0f ;
+			for(int first=0 ; first<count ; first+=4)
 			{
-				m_directionNormal = Math::Vector3(0.0,1.0,0.0) ;
-				m_directionNormal =  m_directionNormal - m_direction*(m_direction*m_directionNormal) ;
-				if(m_directionNormal.norm()<std::numeric_limits<float>::epsilon()*10.0)
+				int lanes = ::std::min(4, count-first) ;
+				float uLanes[4] = { 0.5f, 0.5f, 0.5f, 0.5f } ;
+				float vLanes[4] = { 0.0f, 0.0f, 0.0f, 0.0f } ;
+				for(int lane=0 ; lane<lanes ; ++lane)
 				{
-					m_directionNormal = Math::Vector3(0.0,0.0,1.0) ;
-					m_directionNormal =  m_directionNormal - m_direction*(m_direction*m_directionNormal) ;
-
-				}	
+					uLanes[lane] = u[first+lane] ;
+					vLanes[lane] = v[first+lane] ;
+				}
+				__m128 u4 = _mm_max_ps(_mm_loadu_ps(uLanes), _mm_set1_ps(1.0f/16777216.0f)) ;
+				__m128 cosine, density ;
+				if(diffuse)
+				{
+					// Cosine distribution: cos(theta) = sqrt(u), pdf = cos(theta)/pi
+					cosine = _mm_sqrt_ps(u4) ;
+					density = _mm_mul_ps(normalization, cosine) ;
+				}
+				else
+				{
+					__m128 logU = Math::sse::log4(u4) ;
+					cosine = Math::sse::exp4(_mm_mul_ps(logU, exponent)) ;
+					density = _mm_mul_ps(normalization, Math::sse::exp4(_mm_mul_ps(logU, pdfExponent))) ;
+				}
+				__m128 sine = _mm_sqrt_ps(_mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(cosine, cosine)))) ;
+				__m128 sinPhi, cosPhi ;
+				Math::sse::sinCos2Pi4(_mm_loadu_ps(vLanes), sinPhi, cosPhi) ;
+				__m128 along[3] = { _mm_mul_ps(sine, cosPhi), _mm_mul_ps(sine, sinPhi), cosine } ;
+				float coordinates[3][4] ;
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					__m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(along[0], _mm_set1_ps(m_tangent[axis])),
+														 _mm_mul_ps(along[1], _mm_set1_ps(m_bitangent[axis]))),
+											  _mm_mul_ps(along[2], _mm_set1_ps(m_direction[axis]))) ;
+					_mm_storeu_ps(coordinates[axis], value) ;
+				}
+				float densities[4] ;
+				_mm_storeu_ps(densities, density) ;
+				for(int lane=0 ; lane<lanes ; ++lane)
+				{
+					directions[first+lane] = Math::Vector3(coordinates[0][lane], coordinates[1][lane], coordinates[2][lane]) ;
+					pdf[first+lane] = densities[lane] ;
+				}
 			}
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	Math::Vector3 RandomDirection::generate() const
+		/// \fn	void RandomDirection::generate(SampleStream & samples, int count,
+		/// 	Math::Vector3 * directions, float * pdf) const
 		///
-		/// \brief	Generate a random direction respecting a cosine^n distribution.
+		/// \brief	Generates a batch of random directions respecting a cosine^n distribution.
 		///
-		/// \author	F. Lamarche, University of Rennes 1.
-		/// \date	04/12/2013
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
 		///
-		/// \return	The random direction.
+		/// \param [in,out]	samples   	The samples (two dimensions per direction are used).
+		/// \param	count			  	The number of directions (at most 64).
+		/// \param [out]	directions	The directions.
+		/// \param [out]	pdf		  	The probability densities of the directions.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		Math::Vector3 generate() const
+		void generate(SampleStream & samples, int count, Math::Vector3 * directions, float * pdf) const
 		{
-			::std::pair<float,float> perturbation = randomPolar(m_n) ;
-			Quaternion q1(m_directionNormal, perturbation.first) ;
-			Quaternion q2(m_direction, perturbation.second) ;
-			Math::Quaternion result = q2.rotate(q1.rotate(m_direction)) ;
-			return result.v() ;
+			float u[64], v[64] ;
+			count = ::std::min(count, 64) ;
+			for(int cpt=0 ; cpt<count ; ++cpt)
+			{
+				u[cpt] = samples.random() ;
+				v[cpt] = samples.random() ;
+			}
+			generate(u, v, count, directions, pdf) ;
 		}
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,101 @@
+#ifndef _Math_RandomGenerator_H
+#define _Math_RandomGenerator_H
+
+#include <stdint.h>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RandomGenerator
+	///
+	/// \brief	A PCG32 pseudo random number generator (64 bits state, period 2^64). Each generator
+	/// 		owns its state, so that rendering threads do not share (and lock) a global generator.
+	/// 		Generators built with the same seed and different streams produce independent
+	/// 		sequences: rendering uses one stream per pixel (or per thread) and one seed per pass.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RandomGenerator
+	{
+	protected:
+		/// \brief	The state of the generator.
+		uint64_t m_state ;
+		/// \brief	The increment of the generator (selects the stream, always odd).
+		uint64_t m_increment ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	RandomGenerator::RandomGenerator(uint64_t seed=0, uint64_t stream=0)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	seed  	The seed.
+		/// \param	stream	The stream.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		RandomGenerator(uint64_t seed=0, uint64_t stream=0)
+		{
+			this->seed(seed, stream) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RandomGenerator::seed(uint64_t seed, uint64_t stream)
+		///
+		/// \brief	Restarts the generator on the provided seed and stream.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	seed  	The seed.
+		/// \param	stream	The stream.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void seed(uint64_t seed, uint64_t stream)
+		{
+			m_state = 0 ;
+			m_increment = (stream<<1) | 1 ;
+			next() ;
+			m_state += seed ;
+			next() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	uint32_t RandomGenerator::next()
+		///
+		/// \brief	Generates the next 32 bits random value.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	A uniformly distributed 32 bits value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		uint32_t next()
+		{
+			uint64_t old = m_state ;
+			m_state = old*6364136223846793005ULL + m_increment ;
+			uint32_t xorShifted = (uint32_t)(((old>>18)^old)>>27) ;
+			uint32_t rotation = (uint32_t)(old>>59) ;
+			return (xorShifted>>rotation) | (xorShifted<<((32-rotation)&31)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float RandomGenerator::random()
+		///
+		/// \brief	A random value in interval [0;1[.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	A uniformly distributed random number in [0;1[.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float random()
+		{
+			// 24 bits: every value is exactly representable as a float smaller than 1
+			return (next()>>8)*(1.0f/16777216.0f) ;
+		}
+	} ;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef _Math_RandomSampler_H
+#define _Math_RandomSampler_H
+
+#include <Math/Sampler.h>
+#include <Math/RandomGenerator.h>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RandomSampler
+	///
+	/// \brief	Independent pseudo random samples (PCG32, one stream per pixel). Reference for the low
+	/// 		discrepancy samplers.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RandomSampler : public Sampler
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual float RandomSampler::sample(uint32_t pixel, uint32_t index,
+		/// 	uint32_t dimension) const
+		///
+		/// \brief	Computes a sample.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	pixel	 	The pixel (selects the stream of the generator).
+		/// \param	index	 	The index of the sample in the pixel.
+		/// \param	dimension	The dimension.
+		///
+		/// \return	The sample in [0;1[.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual float sample(uint32_t pixel, uint32_t index, uint32_t dimension) const
+		{
+			RandomGenerator generator(((uint64_t)index<<32) | dimension, pixel) ;
+			return generator.random() ;
+		}
+	} ;
+}
+
+#endif
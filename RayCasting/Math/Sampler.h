@@ -0,0 +1,164 @@
+#ifndef _Math_Sampler_H
+#define _Math_Sampler_H
+
+#include <stdint.h>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Sampler
+	///
+	/// \brief	Interface of the samplers providing the random numbers of the renderers. A sample is a
+	/// 		value in [0;1[ identified by a pixel, the index of the sample in the pixel (the pass
+	/// 		number) and a dimension (see SampleStream). Samplers are stateless: the same sample can
+	/// 		be computed by any thread, in any order. Different pixels get decorrelated sequences.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Sampler
+	{
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static uint32_t Sampler::hash(uint32_t value)
+		///
+		/// \brief	Integer hash function (lowbias32, C. Wellons) used to derive the seeds of the
+		/// 		scramblings from the pixels and the dimensions.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	value	The value.
+		///
+		/// \return	The hashed value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static uint32_t hash(uint32_t value)
+		{
+			value ^= value>>16 ;
+			value *= 0x7feb352dU ;
+			value ^= value>>15 ;
+			value *= 0x846ca68bU ;
+			value ^= value>>16 ;
+			return value ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static float Sampler::toFloat(uint32_t value)
+		///
+		/// \brief	Converts a 32 bits value to a float in [0;1[ (24 most significant bits).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	value	The value.
+		///
+		/// \return	The float.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static float toFloat(uint32_t value)
+		{
+			return (value>>8)*(1.0f/16777216.0f) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual Sampler::~Sampler()
+		///
+		/// \brief	Destructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual ~Sampler()
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual float Sampler::sample(uint32_t pixel, uint32_t index, uint32_t dimension) const = 0
+		///
+		/// \brief	Computes a sample.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	pixel	 	The pixel (index of the pixel in the image).
+		/// \param	index	 	The index of the sample in the pixel.
+		/// \param	dimension	The dimension.
+		///
+		/// \return	The sample in [0;1[.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual float sample(uint32_t pixel, uint32_t index, uint32_t dimension) const = 0 ;
+	} ;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	SampleStream
+	///
+	/// \brief	The samples of one sample of a pixel, read dimension after dimension. Renderers reserve
+	/// 		fixed dimensions for each use of the samples (pixel jitter, light sampling, bounce...)
+	/// 		with SampleStream::setDimension, so that each use gets its own well distributed
+	/// 		dimensions whatever the path followed before.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class SampleStream
+	{
+	protected:
+		/// \brief	The sampler.
+		const Sampler * m_sampler ;
+		/// \brief	The pixel.
+		uint32_t m_pixel ;
+		/// \brief	The index of the sample in the pixel.
+		uint32_t m_index ;
+		/// \brief	The next dimension.
+		uint32_t m_dimension ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	SampleStream::SampleStream(Sampler const & sampler, uint32_t pixel, uint32_t index,
+		/// 	uint32_t dimension=0)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	sampler  	The sampler.
+		/// \param	pixel	 	The pixel.
+		/// \param	index	 	The index of the sample in the pixel.
+		/// \param	dimension	The first dimension.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		SampleStream(Sampler const & sampler, uint32_t pixel, uint32_t index, uint32_t dimension=0)
+			: m_sampler(&sampler), m_pixel(pixel), m_index(index), m_dimension(dimension)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void SampleStream::setDimension(uint32_t dimension)
+		///
+		/// \brief	Sets the dimension of the next sample.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	dimension	The dimension.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void setDimension(uint32_t dimension)
+		{
+			m_dimension = dimension ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float SampleStream::random()
+		///
+		/// \brief	Gets the sample of the current dimension and moves to the next dimension.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The sample in [0;1[.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float random()
+		{
+			return m_sampler->sample(m_pixel, m_index, m_dimension++) ;
+		}
+	} ;
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef _Math_SobolSampler_H
+#define _Math_SobolSampler_H
+
+#include <Math/Sampler.h>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	SobolSampler
+	///
+	/// \brief	Owen scrambled Sobol samples (hash based nested uniform scrambling, B. Burley, "Practical
+	/// 		Hash-based Owen Scrambling", JCGT 2020). Dimensions are grouped by four: each group
+	/// 		uses the first four Sobol dimensions with its own scrambling and its own shuffling of
+	/// 		the sample indices, seeded by the pixel and the group. Consecutive dimensions of a group
+	/// 		(pixel jitter, point on a light, bounce direction) are therefore stratified together,
+	/// 		and pixels and groups are decorrelated.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class SobolSampler : public Sampler
+	{
+	protected:
+		/// \brief	The generator matrices of the first four dimensions (one column per bit of the index).
+		uint32_t m_directions[4][32] ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static uint32_t SobolSampler::reverseBits(uint32_t value)
+		///
+		/// \brief	Reverses the bits of a value.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	value	The value.
+		///
+		/// \return	The reversed value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static uint32_t reverseBits(uint32_t value)
+		{
+			value = (value<<16) | (value>>16) ;
+			value = ((value&0x00ff00ffU)<<8) | ((value&0xff00ff00U)>>8) ;
+			value = ((value&0x0f0f0f0fU)<<4) | ((value&0xf0f0f0f0U)>>4) ;
+			value = ((value&0x33333333U)<<2) | ((value&0xccccccccU)>>2) ;
+			value = ((value&0x55555555U)<<1) | ((value&0xaaaaaaaaU)>>1) ;
+			return value ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static uint32_t SobolSampler::scramble(uint32_t value, uint32_t seed)
+		///
+		/// \brief	Nested uniform (Owen) scrambling of a value: each bit is flipped depending on the
+		/// 		more significant bits and the seed (Laine-Karras hash on the reversed bits).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	value	The value.
+		/// \param	seed 	The seed of the scrambling.
+		///
+		/// \return	The scrambled value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static uint32_t scramble(uint32_t value, uint32_t seed)
+		{
+			value = reverseBits(value) ;
+			value += seed ;
+			value ^= value*0x6c50b47cU ;
+			value ^= value*0xb82f1e52U ;
+			value ^= value*0xc7afe638U ;
+			value ^= value*0x8d22f6e6U ;
+			return reverseBits(value) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	uint32_t SobolSampler::sobol(uint32_t index, int dimension) const
+		///
+		/// \brief	Computes a (non scrambled) Sobol sample.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	 	The index of the sample.
+		/// \param	dimension	The dimension (in [0;3]).
+		///
+		/// \return	The sample as a 32 bits fixed point value.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		uint32_t sobol(uint32_t index, int dimension) const
+		{
+			uint32_t result = 0 ;
+			for(int bit=0 ; index!=0 ; ++bit, index>>=1)
+			{
+				if(index&1) { result ^= m_directions[dimension][bit] ; }
+			}
+			return result ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	SobolSampler::SobolSampler()
+		///
+		/// \brief	Constructor, computes the generator matrices from the primitive polynomials and the
+		/// 		initial direction numbers of S. Joe and F. Kuo.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		SobolSampler()
+		{
+			// Degree, coefficients and initial direction numbers of the dimensions 2 to 4
+			const int degree[3] = { 1, 2, 3 } ;
+			const uint32_t coefficients[3] = { 0, 1, 1 } ;
+			const uint32_t initial[3][3] = { { 1, 0, 0 }, { 1, 3, 0 }, { 1, 3, 1 } } ;
+			// First dimension: van der Corput sequence
+			for(int bit=0 ; bit<32 ; ++bit)
+			{
+				m_directions[0][bit] = 1U<<(31-bit) ;
+			}
+			for(int dimension=1 ; dimension<4 ; ++dimension)
+			{
+				int s = degree[dimension-1] ;
+				uint32_t a = coefficients[dimension-1] ;
+				uint32_t * v = m_directions[dimension] ;
+				for(int bit=0 ; bit<s ; ++bit)
+				{
+					v[bit] = initial[dimension-1][bit]<<(31-bit) ;
+				}
+				for(int bit=s ; bit<32 ; ++bit)
+				{
+					v[bit] = v[bit-s] ^ (v[bit-s]>>s) ;
+					for(int k=1 ; k<s ; ++k)
+					{
+						if((a>>(s-1-k))&1) { v[bit] ^= v[bit-k] ; }
+					}
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual float SobolSampler::sample(uint32_t pixel, uint32_t index,
+		/// 	uint32_t dimension) const
+		///
+		/// \brief	Computes a sample.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	pixel	 	The pixel.
+		/// \param	index	 	The index of the sample in the pixel.
+		/// \param	dimension	The dimension.
+		///
+		/// \return	The sample in [0;1[.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual float sample(uint32_t pixel, uint32_t index, uint32_t dimension) const
+		{
+			uint32_t seed = hash(pixel ^ hash(dimension/4)) ;
+			uint32_t shuffled = scramble(index, seed) ;
+			return toFloat(scramble(sobol(shuffled, dimension%4), hash(seed+dimension%4+1))) ;
+		}
+	} ;
+}
+
+#endif
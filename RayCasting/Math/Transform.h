@@ -0,0 +1,306 @@
+#ifndef _Math_Transform_H
+#define _Math_Transform_H
+
+#include <Math/Vector3.h>
+#include <Math/Quaternion.h>
+
+namespace Math
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	Transform
+	///
+	/// \brief	An affine transform from a local frame to the world frame, stored with its inverse.
+	/// 		The transform is modified with the same methods as Geometry::Geometry (relatively to the
+	/// 		world origin), so that an object placed by a transform is where the transformed vertices
+	/// 		would be.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class Transform
+	{
+	protected:
+		/// \brief	The origin of the local frame (in world space).
+		Vector3 m_origin ;
+		/// \brief	The axes of the local frame (columns of the linear part, scale included).
+		Vector3 m_axis[3] ;
+		/// \brief	The rows of the inverse of the linear part.
+		Vector3 m_toLocal[3] ;
+		/// \brief	The determinant of the linear part.
+		float m_determinant ;
+		/// \brief	true if the transform is exactly the identity.
+		bool m_identity ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Transform::update()
+		///
+		/// \brief	Updates the inverse transform. Called after each modification.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void update()
+		{
+			Vector3 bc = m_axis[1]^m_axis[2] ;
+			m_determinant = m_axis[0]*bc ;
+			m_toLocal[0] = bc/m_determinant ;
+			m_toLocal[1] = (m_axis[2]^m_axis[0])/m_determinant ;
+			m_toLocal[2] = (m_axis[0]^m_axis[1])/m_determinant ;
+			m_identity = m_origin[0]==0.0f && m_origin[1]==0.0f && m_origin[2]==0.0f ;
+			for(int cpt=0 ; cpt<3 ; ++cpt)
+			{
+				for(int axis=0 ; axis<3 ; ++axis)
+				{
+					m_identity = m_identity && m_axis[cpt][axis]==(cpt==axis ? 1.0f : 0.0f) ;
+				}
+			}
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Transform::Transform()
+		///
+		/// \brief	Default constructor (identity).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Transform()
+			: m_origin(0.0f, 0.0f, 0.0f)
+		{
+			m_axis[0] = Vector3(1.0f, 0.0f, 0.0f) ;
+			m_axis[1] = Vector3(0.0f, 1.0f, 0.0f) ;
+			m_axis[2] = Vector3(0.0f, 0.0f, 1.0f) ;
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Transform::Transform(Vector3 const & origin, Vector3 const & x, Vector3 const & y,
+		/// 	Vector3 const & z)
+		///
+		/// \brief	Constructor from the local frame.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	origin	The origin of the local frame (in world space).
+		/// \param	x	  	The X axis of the local frame (in world space).
+		/// \param	y	  	The Y axis of the local frame (in world space).
+		/// \param	z	  	The Z axis of the local frame (in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Transform(Vector3 const & origin, Vector3 const & x, Vector3 const & y, Vector3 const & z)
+			: m_origin(origin)
+		{
+			m_axis[0] = x ;
+			m_axis[1] = y ;
+			m_axis[2] = z ;
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool Transform::identity() const
+		///
+		/// \brief	Tests if the transform is exactly the identity.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if the transform is the identity.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool identity() const
+		{ return m_identity ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	float Transform::determinant() const
+		///
+		/// \brief	Gets the determinant of the linear part (negative for mirror transforms).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The determinant.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		float determinant() const
+		{ return m_determinant ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Vector3 const & Transform::origin() const
+		///
+		/// \brief	Gets the origin of the local frame.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The origin (in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Vector3 const & origin() const
+		{ return m_origin ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Vector3 const & Transform::axis(int index) const
+		///
+		/// \brief	Gets an axis of the local frame.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	index	The axis (0, 1 or 2).
+		///
+		/// \return	The axis (in world space, scale included).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Vector3 const & axis(int index) const
+		{ return m_axis[index] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Vector3 Transform::toWorld(Vector3 const & point) const
+		///
+		/// \brief	Transforms a point from the local frame to the world frame.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	point	The point (in the local frame).
+		///
+		/// \return	The point (in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Vector3 toWorld(Vector3 const & point) const
+		{ return m_origin+m_axis[0]*point[0]+m_axis[1]*point[1]+m_axis[2]*point[2] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Vector3 Transform::toLocal(Vector3 const & point) const
+		///
+		/// \brief	Transforms a point from the world frame to the local frame.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	point	The point (in world space).
+		///
+		/// \return	The point (in the local frame).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Vector3 toLocal(Vector3 const & point) const
+		{ return directionToLocal(point-m_origin) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Vector3 Transform::directionToLocal(Vector3 const & direction) const
+		///
+		/// \brief	Transforms a direction from the world frame to the local frame (the result is not
+		/// 		normalized: its norm is the local length of a unit world length along the direction).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	direction	The direction (in world space).
+		///
+		/// \return	The direction (in the local frame).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Vector3 directionToLocal(Vector3 const & direction) const
+		{ return Vector3(m_toLocal[0]*direction, m_toLocal[1]*direction, m_toLocal[2]*direction) ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	Vector3 Transform::normalToWorld(Vector3 const & normal) const
+		///
+		/// \brief	Transforms a normal from the local frame to the world frame (by the transpose of the
+		/// 		inverse transform).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	normal	The normal (in the local frame).
+		///
+		/// \return	The normalized normal (in world space).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		Vector3 normalToWorld(Vector3 const & normal) const
+		{ return (m_toLocal[0]*normal[0]+m_toLocal[1]*normal[1]+m_toLocal[2]*normal[2]).normalized() ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Transform::translate(Vector3 const & t)
+		///
+		/// \brief	Appends a translation.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	t	The translation vector.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void translate(Vector3 const & t)
+		{
+			m_origin = m_origin+t ;
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Transform::scale(float v)
+		///
+		/// \brief	Appends a scale (relatively to the world origin).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	v	The scale factor.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scale(float v)
+		{
+			m_origin = m_origin*v ;
+			for(int cpt=0 ; cpt<3 ; ++cpt) { m_axis[cpt] = m_axis[cpt]*v ; }
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Transform::scaleAxis(int axis, float v)
+		///
+		/// \brief	Appends a scale on a world axis (relatively to the world origin).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	axis	The axis (0, 1 or 2).
+		/// \param	v   	The scale factor.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void scaleAxis(int axis, float v)
+		{
+			m_origin[axis] = m_origin[axis]*v ;
+			for(int cpt=0 ; cpt<3 ; ++cpt) { m_axis[cpt][axis] = m_axis[cpt][axis]*v ; }
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Transform::rotate(Quaternion const & q)
+		///
+		/// \brief	Appends a rotation (around the world origin).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	q	Quaternion describing the rotation.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void rotate(Quaternion const & q)
+		{
+			m_origin = q.rotate(m_origin).v() ;
+			for(int cpt=0 ; cpt<3 ; ++cpt) { m_axis[cpt] = q.rotate(m_axis[cpt]).v() ; }
+			update() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void Transform::transform(Transform const & t)
+		///
+		/// \brief	Appends an affine transform.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	t	The transform applied after this one.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void transform(Transform const & t)
+		{
+			m_origin = t.toWorld(m_origin) ;
+			for(int cpt=0 ; cpt<3 ; ++cpt)
+			{
+				m_axis[cpt] = t.m_axis[0]*m_axis[cpt][0]+t.m_axis[1]*m_axis[cpt][1]+t.m_axis[2]*m_axis[cpt][2] ;
+			}
+			update() ;
+		}
+	} ;
+}
+
+#endif
@@ -3,7 +3,19 @@
 
 #include <math.h>
 #include <iostream>
-#include <Math/Object.h>
+#include <type_traits>
+
+// C++ 11 (constexpr, type traits) is not supported by Visual C++ 2010 (toolset of the Release
+// configuration).
+#if !defined(CPP11_OPT) && ((defined(_MSC_VER) && _MSC_VER>=1900) || (!defined(_MSC_VER) && __cplusplus>=201103L))
+#define CPP11_OPT
+#endif
+
+// The SSE version is the default on x86-64 (SSE 2 is always available), NO_SSE_OPT selects the
+// scalar version.
+#if !defined(SSE_OPT) && !defined(NO_SSE_OPT) && (defined(__x86_64__) || defined(_M_X64))
+#define SSE_OPT
+#endif
 
 #ifdef SSE_OPT
 
@@ -17,11 +29,14 @@ namespace Math
 	/// \class	Vector3
 	///
 	/// \brief	A 3D vector.
+	/// 		
+	/// 		Standard layout and trivially copyable (three floats, no virtual method): arrays of
+	/// 		vectors can be copied with memcpy or read from a file.
 	///
 	/// \author	F. Lamarche, Universit de Rennes 1
 	/// \date	03/12/2013
 	////////////////////////////////////////////////////////////////////////////////////////////////////
-	class Vector3 : public Object
+	class Vector3
 	{
 	protected:
 		/// The coordinates of the vector
@@ -41,12 +56,18 @@ namespace Math
 		/// \param	y	The y coordinate.
 		/// \param	z	The z coordinate.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef CPP11_OPT
+		constexpr Vector3(float x=0, float y=0, float z=0)
+			: m_vector{x, y, z}
+		{}
+#else
 		Vector3(float x=0, float y=0, float z=0)
 		{
 			m_vector[0] = x ;
 			m_vector[1] = y ;
 			m_vector[2] = z ;
 		}
+#endif
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	const float & Vector3::operator[] (int index) const
@@ -209,7 +230,7 @@ namespace Math
 		///
 		/// \return	The result of the operation.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		__forceinline Vector3 operator^(Vector3 const & v) const
+		Vector3 operator^(Vector3 const & v) const
 		{
 			Vector3 result ;
 			result[0] = m_vector[1]*v[2]-m_vector[2]*v[1] ;
@@ -393,6 +414,12 @@ namespace Math
 		}
 	} ;
 
+	static_assert(sizeof(Vector3)==3*sizeof(float), "Math::Vector3 must only contain its coordinates") ;
+	static_assert(::std::alignment_of<Vector3>::value==::std::alignment_of<float>::value, "Math::Vector3 must be aligned as float") ;
+#ifdef CPP11_OPT
+	static_assert(::std::is_standard_layout<Vector3>::value && ::std::is_trivially_copyable<Vector3>::value, "Math::Vector3 must be a POD-like type") ;
+#endif
+
 
 }
 
@@ -0,0 +1,134 @@
+#ifndef _Math_sse_Float4_approximations_H
+#define _Math_sse_Float4_approximations_H
+
+#include <emmintrin.h>
+
+namespace Math
+{
+	namespace sse
+	{
+		// Polynomial approximations of transcendental functions on four floats (SSE2 only), shared by
+		// the batched direction sampling and the denoiser.
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	inline __m128 log4(__m128 x)
+		///
+		/// \brief	Natural logarithm of four positive values (polynomial approximation of Cephes,
+		/// 		relative error below 1e-6).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The values (larger than the smallest normalized float).
+		///
+		/// \return	The logarithms.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline __m128 log4(__m128 x)
+		{
+			const __m128 one = _mm_set1_ps(1.0f) ;
+			// x = m.2^e with m in [0.5;1[
+			__m128i bits = _mm_castps_si128(x) ;
+			__m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126))) ;
+			__m128 m = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x807fffff))), _mm_set1_ps(0.5f)) ;
+			// m in [sqrt(0.5);sqrt(2)[
+			__m128 below = _mm_cmplt_ps(m, _mm_set1_ps(0.707106781186547524f)) ;
+			e = _mm_sub_ps(e, _mm_and_ps(one, below)) ;
+			m = _mm_add_ps(_mm_sub_ps(m, one), _mm_and_ps(m, below)) ;
+			__m128 z = _mm_mul_ps(m, m) ;
+			__m128 y = _mm_set1_ps(7.0376836292e-2f) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.1514610310e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1676998740e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.2420140846e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.4249322787e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.6668057665e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.0000714765e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-2.4999993993e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(3.3333331174e-1f)) ;
+			y = _mm_mul_ps(_mm_mul_ps(y, m), z) ;
+			y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f))) ;
+			y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f))) ;
+			return _mm_add_ps(_mm_add_ps(m, y), _mm_mul_ps(e, _mm_set1_ps(0.693359375f))) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	inline __m128 exp4(__m128 x)
+		///
+		/// \brief	Exponential of four values (polynomial approximation of Cephes, relative error below
+		/// 		1e-6).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	The values (in [-87;0]).
+		///
+		/// \return	The exponentials.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline __m128 exp4(__m128 x)
+		{
+			x = _mm_max_ps(x, _mm_set1_ps(-87.0f)) ;
+			// x = k.ln(2)+r, |r|<=ln(2)/2
+			__m128 k = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f)) ;
+			__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(k)) ;
+			k = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, k), _mm_set1_ps(1.0f))) ;
+			x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(0.693359375f))) ;
+			x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(-2.12194440e-4f))) ;
+			__m128 z = _mm_mul_ps(x, x) ;
+			__m128 y = _mm_set1_ps(1.9875691500e-4f) ;
+			y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f)) ;
+			y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f)) ;
+			y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f)) ;
+			// 2^k
+			__m128i power = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(k), _mm_set1_epi32(127)), 23) ;
+			return _mm_mul_ps(y, _mm_castsi128_ps(power)) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	inline void sinCos2Pi4(__m128 v, __m128 & sine, __m128 & cosine)
+		///
+		/// \brief	Sine and cosine of 2.pi.v for four values (quadrant reduction and Taylor polynomials
+		/// 		on [-pi/4;pi/4], absolute error below 1e-6).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	v		  	The values (in [0;1[).
+		/// \param [out]	sine  	The sines.
+		/// \param [out]	cosine	The cosines.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		inline void sinCos2Pi4(__m128 v, __m128 & sine, __m128 & cosine)
+		{
+			// Quadrant and angle in the quadrant, centered: y in [-pi/4;pi/4[
+			__m128 t = _mm_mul_ps(v, _mm_set1_ps(4.0f)) ;
+			__m128 quadrant = _mm_cvtepi32_ps(_mm_cvttps_epi32(t)) ;
+			__m128 y = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(t, quadrant), _mm_set1_ps(0.5f)), _mm_set1_ps(1.57079632679489662f)) ;
+			__m128 y2 = _mm_mul_ps(y, y) ;
+			__m128 s = _mm_set1_ps(-1.0f/5040.0f) ;
+			s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(1.0f/120.0f)) ;
+			s = _mm_add_ps(_mm_mul_ps(s, y2), _mm_set1_ps(-1.0f/6.0f)) ;
+			s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, y2), y), y) ;
+			__m128 c = _mm_set1_ps(1.0f/40320.0f) ;
+			c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(-1.0f/720.0f)) ;
+			c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(1.0f/24.0f)) ;
+			c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(-0.5f)) ;
+			c = _mm_add_ps(_mm_mul_ps(c, y2), _mm_set1_ps(1.0f)) ;
+			// Angle in the quadrant: y+pi/4
+			const __m128 invSqrt2 = _mm_set1_ps(0.707106781186547524f) ;
+			__m128 sinQ = _mm_mul_ps(_mm_add_ps(c, s), invSqrt2) ;
+			__m128 cosQ = _mm_mul_ps(_mm_sub_ps(c, s), invSqrt2) ;
+			// Rotation by quadrant.pi/2
+			__m128 swap = _mm_or_ps(_mm_cmpeq_ps(quadrant, _mm_set1_ps(1.0f)), _mm_cmpeq_ps(quadrant, _mm_set1_ps(3.0f))) ;
+			__m128 sineNegative = _mm_cmpge_ps(quadrant, _mm_set1_ps(2.0f)) ;
+			__m128 cosineNegative = _mm_or_ps(_mm_cmpeq_ps(quadrant, _mm_set1_ps(1.0f)), _mm_cmpeq_ps(quadrant, _mm_set1_ps(2.0f))) ;
+			const __m128 sign = _mm_set1_ps(-0.0f) ;
+			sine = _mm_or_ps(_mm_and_ps(swap, cosQ), _mm_andnot_ps(swap, sinQ)) ;
+			cosine = _mm_or_ps(_mm_and_ps(swap, sinQ), _mm_andnot_ps(swap, cosQ)) ;
+			sine = _mm_xor_ps(sine, _mm_and_ps(sineNegative, sign)) ;
+			cosine = _mm_xor_ps(cosine, _mm_and_ps(cosineNegative, sign)) ;
+		}
+	}
+}
+
+#endif
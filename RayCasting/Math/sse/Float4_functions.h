@@ -2,8 +2,15 @@
 #define _Rennes1_Math_sse_Float4_H
 
 #include <assert.h>
+#include <emmintrin.h>
 #include <smmintrin.h>
 
+// SSE 4.1 instructions (dot product, rounding) are used when the compiler targets them, SSE 2
+// otherwise (always available on x86-64). MSVC does not report the instruction set.
+#if !defined(SSE4_OPT) && (defined(_MSC_VER) || defined(__SSE4_1__))
+#define SSE4_OPT
+#endif
+
 namespace Math
 {
 		namespace sse
@@ -15,9 +22,9 @@ namespace Math
 			/// 
 			/// \author F. Lamarche, University of Rennes 1.
 			///////////////////////////////////////////////////////////////////////////////////
-			_declspec(align(16)) static const union
+			static const union
 			{
-				__int32 i[4];
+				int i[4];
 				__m128 m;
 			} Float4_absMask = {0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff};
 
@@ -26,9 +33,9 @@ namespace Math
 			/// 
 			/// \author F. Lamarche, University of Rennes 1.
 			///////////////////////////////////////////////////////////////////////////////////
-			_declspec(align(16)) static const union
+			static const union
 			{
-				__int32 i[4];
+				int i[4];
 				__m128 m;
 			} Float4_negateMask = {~0x7fffffff, ~0x7fffffff, ~0x7fffffff, ~0x7fffffff};
 
@@ -37,45 +44,59 @@ namespace Math
 			/// 
 			/// \author F. Lamarche, University of Rennes 1.
 			///////////////////////////////////////////////////////////////////////////////////
-			_declspec(align(16)) static const union
+			static const union
 			{
-				__int32 i[4];
+				int i[4];
 				__m128 m;
 			} Float4_negateMaskFirst = {~0x7fffffff, 0, 0, 0};
 
-			_declspec(align(16)) static const union
+			static const union
 			{
-				__int32 i[4];
+				int i[4];
 				__m128 m;
 			} Float4_negateMaskSecond = {0, ~0x7fffffff, 0, 0};
 
-			_declspec(align(16)) static const union
+			static const union
 			{
-				__int32 i[4];
+				int i[4];
 				__m128 m;
 			} Float4_negateMaskThird = {0, 0, ~0x7fffffff , 0};
 
-			_declspec(align(16)) static const union
+			static const union
 			{
-				__int32 i[4];
+				int i[4];
 				__m128 m;
 			} Float4_negateMaskFourth = {0, 0 ,0, ~0x7fffffff};
+
+			///////////////////////////////////////////////////////////////////////////////////
+			/// \brief Mask keeping the three first coordinates of a float4
+			/// 
+			/// \author A. Roca, Universit de Rennes 1
+			///////////////////////////////////////////////////////////////////////////////////
+			static const union
+			{
+				int i[4];
+				__m128 m;
+			} Float4_xyzMask = {~0, ~0, ~0, 0};
 		}
 }
 
 
 inline Math::sse::Float4 makeFloat4(float value)
 {
-	Math::sse::Float4 result = {value, value, value, value} ;
-	return result ;
+	return _mm_set1_ps(value) ;
 }
 
 inline Math::sse::Float4 makeFloat4(float v0, float v1, float v2, float v3)
 {
-	Math::sse::Float4 result = {v0, v1, v2, v3} ;
-	return result ;
+	return _mm_setr_ps(v0, v1, v2, v3) ;
 }
 
+// With MSVC, __m128 is a union: operators can be overloaded. With GCC and Clang, it is a built-in
+// vector type: operators cannot be overloaded (arithmetic operators are native). The named functions
+// (simdXXX, get, dot, min...) are available with all compilers.
+#ifdef _MSC_VER
+
 inline Math::sse::Float4 operator +(Math::sse::Float4 const & v0, Math::sse::Float4 const & v1)
 {
 	return _mm_add_ps(v0, v1) ;
@@ -123,10 +144,11 @@ inline Math::sse::Float4 operator |(Math::sse::Float4 const & v0, Math::sse::Flo
 
 inline Math::sse::Float4 operator ~(Math::sse::Float4 const & v0)
 {
-	int cst=-1;
-	return makeFloat4(reinterpret_cast<const float &>(cst))^v0 ;
+	return _mm_xor_ps(_mm_castsi128_ps(_mm_set1_epi32(-1)), v0) ;
 }
 
+#endif
+
 inline Math::sse::Float4 simdEquals(Math::sse::Float4 const & v0, Math::sse::Float4 const & v1)
 {
 	return _mm_cmpeq_ps(v0, v1) ;
@@ -155,17 +177,38 @@ inline Math::sse::Float4 simdGreaterEquals(Math::sse::Float4 const & v0, Math::s
 inline float & get(Math::sse::Float4 & v, int index)
 {
 	assert(index>=0 && index<4) ;
-	return v.m128_f32[index] ;
+	return reinterpret_cast<float*>(&v)[index] ;
 }
 
 inline float const & get(Math::sse::Float4 const & v, int index)
 {
 	assert(index>=0 && index<4) ;
-	return v.m128_f32[index] ;
+	return reinterpret_cast<float const*>(&v)[index] ;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	inline float dot(Math::sse::Float4 const & v0, Math::sse::Float4 const & v1)
+///
+/// \brief	Dot product of the three first coordinates (the fourth one is ignored).
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	v0	The first vector.
+/// \param	v1	The second vector.
+///
+/// \return	v0[0]*v1[0]+v0[1]*v1[1]+v0[2]*v1[2].
+////////////////////////////////////////////////////////////////////////////////////////////////////
 inline float dot(Math::sse::Float4 const & v0, Math::sse::Float4 const & v1)
-{ return  get(_mm_dp_ps(v0, v1, 0xFF),0) ; }
+{
+#ifdef SSE4_OPT
+	return _mm_cvtss_f32(_mm_dp_ps(v0, v1, 0x71)) ;
+#else
+	__m128 product = _mm_mul_ps(v0, v1) ;
+	__m128 sum = _mm_add_ss(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1))) ;
+	return _mm_cvtss_f32(_mm_add_ss(sum, _mm_movehl_ps(product, product))) ;
+#endif
+}
 
 inline Math::sse::Float4 min(Math::sse::Float4 const & v0, Math::sse::Float4 const & v1)
 { return _mm_min_ps(v0,v1) ; }
@@ -175,9 +218,11 @@ inline Math::sse::Float4 max(Math::sse::Float4 const & v0, Math::sse::Float4 con
 
 inline Math::sse::Float4 abs(Math::sse::Float4 const & v)
 { 
-	return v & Math::sse::Float4_absMask.m ;
+	return _mm_and_ps(v, Math::sse::Float4_absMask.m) ;
 }
 
+#ifdef SSE4_OPT
+
 inline Math::sse::Float4 floor(Math::sse::Float4 const & v0)
 { return _mm_floor_ps(v0) ; }
 
@@ -187,6 +232,26 @@ inline Math::sse::Float4 ceil(Math::sse::Float4 const & v0)
 inline Math::sse::Float4 round(Math::sse::Float4 const & v0)
 { return _mm_round_ps(v0, _MM_FROUND_TO_NEAREST_INT) ; }
 
+#else
+
+// SSE 2 versions, valid for values lower than 2^31 in absolute value
+inline Math::sse::Float4 floor(Math::sse::Float4 const & v0)
+{ 
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v0)) ;
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v0), _mm_set1_ps(1.0f))) ;
+}
+
+inline Math::sse::Float4 ceil(Math::sse::Float4 const & v0)
+{ 
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v0)) ;
+	return _mm_add_ps(truncated, _mm_and_ps(_mm_cmplt_ps(truncated, v0), _mm_set1_ps(1.0f))) ;
+}
+
+inline Math::sse::Float4 round(Math::sse::Float4 const & v0)
+{ return _mm_cvtepi32_ps(_mm_cvtps_epi32(v0)) ; }
+
+#endif
+
 inline Math::sse::Float4 sqrt(Math::sse::Float4 const & v0)
 { 
 	return _mm_sqrt_ps(v0) ; 
@@ -242,16 +307,18 @@ Math::sse::Float4 shuffle(Math::sse::Float4 const & v)
 	return shuffle<i0,i1,i2,i3>(v,v) ;
 }
 
-Math::sse::Float4 rotateLeft(Math::sse::Float4 const & value)
+inline Math::sse::Float4 rotateLeft(Math::sse::Float4 const & value)
 {
 	return shuffle<1,2,3,0>(value, value) ;
 }
 
-Math::sse::Float4 rotateRight(Math::sse::Float4 const & value)
+inline Math::sse::Float4 rotateRight(Math::sse::Float4 const & value)
 {
 	return shuffle<3,0,1,2>(value, value) ;
 }
 
+#ifdef _MSC_VER
+
 ///////////////////////////////////////////////////////////////////////////////////
 /// \brief Lexicographical == comparison
 /// 
@@ -339,5 +406,7 @@ inline bool operator>= (Math::sse::Float4 const & v0, Math::sse::Float4 const &
 	return !(v0<v1) ;
 }
 
+#endif
+
 
 #endif
\ No newline at end of file
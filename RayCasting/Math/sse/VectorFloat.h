@@ -2,10 +2,9 @@
 #define _Rennes1_Math_VectorFloat_H
 
 #include <iostream>
+#include <type_traits>
 #include <Math/sse/Float4_functions.h>
 
-#include <emmintrin.h>
-
 
 namespace Math
 {
@@ -15,6 +14,10 @@ namespace Math
 	///
 	/// \brief	Class representing m_vector N-dimensional vector. 
 	///
+	/// 		The coordinates are stored in a __m128 whose fourth coordinate is always 0. Only SSE
+	/// 		intrinsics are used (no compiler specific access to the coordinates), the class has the
+	/// 		same interface as the scalar version of Math/Vector3.h.
+	///
 	/// \param Float The scalar type.
 	/// \param dimensions The dimension of the vector
 	/// 
@@ -31,48 +34,43 @@ namespace Math
 		{}
 	public:
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	Vector()
-		///
-		/// \brief	Default constructor. 
-		///
-		/// \author	Fabrice Lamarche, University Of Rennes 1
-		/// \date	23/01/2010
-		////////////////////////////////////////////////////////////////////////////////////////////////////
-		Vector3() 
-		{
-			m_vector = makeFloat4(0.0, 0.0, 0.0, 0.0) ;
-		}
-
-		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	Vector(Float const & value)
+		/// \fn	Vector3::Vector3(float x=0, float y=0, float z=0)
 		///
-		/// \brief	Constructor that initializes each coordinate with the given value. 
+		/// \brief	Constructor (same default values as the scalar version).
 		///
-		/// \author	Fabrice Lamarche, University Of Rennes 1
-		/// \date	23/01/2010
+		/// \author	F. Lamarche, Universit de Rennes 1
+		/// \date	08/12/2013
 		///
-		/// \param value	the value of each coordinate. 
+		/// \param	x	The x coordinate.
+		/// \param	y	The y coordinate.
+		/// \param	z	The z coordinate.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		Vector3(float const & value)
-		{
-			m_vector = makeFloat4(value, value, value, 0.0) ; //makeDouble2(value, value) ;
-		}
+#ifdef CPP11_OPT
+		constexpr Vector3(float x=0, float y=0, float z=0)
+			: m_vector{x, y, z, 0.0f}
+		{}
+#else
+		Vector3(float x=0, float y=0, float z=0)
+			: m_vector(_mm_setr_ps(x, y, z, 0.0f))
+		{}
+#endif
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	Vector3::Vector3(float x, float y, float z)
+		/// \fn	Vector3 & Vector3::operator= (float const & s)
 		///
-		/// \brief	Constructor.
+		/// \brief	Fills the vector with a given scalar
 		///
-		/// \author	F. Lamarche, Universit de Rennes 1
-		/// \date	08/12/2013
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
 		///
-		/// \param	x	The x coordinate.
-		/// \param	y	The y coordinate.
-		/// \param	z	The z coordinate.
+		/// \param	s	The value of all coordinates.
+		///
+		/// \return	*this.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		Vector3(float x, float y, float z)
+		Vector3 & operator= (float const & s)
 		{
-			m_vector = makeFloat4(x,y,z,0.0) ;
+			m_vector = _mm_setr_ps(s, s, s, 0.0f) ;
+			return *this ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -119,7 +117,7 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		const float & operator[] (int index) const
 		{
-			return m_vector.m128_f32[index] ;
+			return get(m_vector, index) ;
 		}
 
 
@@ -137,7 +135,7 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		float & operator[] (int index) 
 		{ 
-			return m_vector.m128_f32[index] ;
+			return get(m_vector, index) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -155,7 +153,7 @@ namespace Math
 		Vector3 operator+ (Vector3 const & v) const
 		{
 			Vector3 result ;
-			result.m_vector = m_vector+v.m_vector ;
+			result.m_vector = _mm_add_ps(m_vector, v.m_vector) ;
 			return result; 
 		}
 
@@ -174,7 +172,7 @@ namespace Math
 		Vector3 operator- (Vector3 const & v) const
 		{
 			Vector3 result ;
-			result.m_vector = m_vector-v.m_vector ;
+			result.m_vector = _mm_sub_ps(m_vector, v.m_vector) ;
 			return result ;
 		}
 
@@ -191,7 +189,7 @@ namespace Math
 		Vector3 operator- () const
 		{
 			Vector3 result ;
-			result.m_vector = m_vector*-1.0 ;
+			result.m_vector = _mm_sub_ps(_mm_setzero_ps(), m_vector) ;
 			return result ;
 		}
 
@@ -227,7 +225,7 @@ namespace Math
 		Vector3 operator* (float const & v) const
 		{
 			Vector3 result ;
-			result.m_vector = m_vector*v ;
+			result.m_vector = _mm_mul_ps(m_vector, _mm_set1_ps(v)) ;
 			return result ;
 		}
 
@@ -247,7 +245,7 @@ namespace Math
 		Vector3 operator/ (float const & v) const
 		{
 			Vector3 result ;
-			result.m_vector = m_vector/v ;
+			result.m_vector = _mm_div_ps(m_vector, _mm_set1_ps(v)) ;
 			return result ;
 		}
 
@@ -358,7 +356,7 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Math::Vector3 simdMul(Math::Vector3 const & v) const
 		{
-			return m_vector*v.m_vector ;
+			return _mm_mul_ps(m_vector, v.m_vector) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -375,7 +373,8 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Math::Vector3 simdDiv(Math::Vector3 const & v) const
 		{
-			return m_vector/v.m_vector ;
+			// 0/0 in the fourth coordinate
+			return _mm_and_ps(_mm_div_ps(m_vector, v.m_vector), sse::Float4_xyzMask.m) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -390,11 +389,15 @@ namespace Math
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Math::Vector3 simdInv() const
 		{
-			sse::Float4 result = makeFloat4(1.0,1.0,1.0,0.0)/m_vector ;
-			result.m128_f32[3] = 0.0 ;
-			return result ;
+			return _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), m_vector), sse::Float4_xyzMask.m) ;
 		}
 	} ;
+
+	static_assert(sizeof(Vector3)==4*sizeof(float), "Math::Vector3 must only contain its coordinates") ;
+	static_assert(::std::alignment_of<Vector3>::value==16, "Math::Vector3 must be aligned on 16 bytes (SSE loads)") ;
+#ifdef CPP11_OPT
+	static_assert(::std::is_standard_layout<Vector3>::value && ::std::is_trivially_copyable<Vector3>::value, "Math::Vector3 must be a POD-like type") ;
+#endif
 }
 
 
@@ -0,0 +1,217 @@
+#ifndef _CpuFeatures_H
+#define _CpuFeatures_H
+
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+
+/// \brief	Attributes of the kernels written for an instruction set which is not enabled for the whole
+/// 		program (they are only called if CpuFeatures reports the instruction set). MSVC compiles
+/// 		the intrinsics of all instruction sets without attribute, AVX-512 intrinsics are available
+/// 		since Visual C++ 2017. AVX-512 implies FMA for GCC: multiplications and additions must not
+/// 		be fused, so that all the kernels compute the same results.
+#if defined(_MSC_VER)
+#define TARGET_AVX
+#define TARGET_AVX512
+#if _MSC_VER>=1911
+#define AVX512_KERNELS
+#endif
+#elif defined(__clang__)
+#define TARGET_AVX __attribute__((target("avx")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#define AVX512_KERNELS
+#else
+#define TARGET_AVX __attribute__((target("avx")))
+#define TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#define AVX512_KERNELS
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \class	CpuFeatures
+///
+/// \brief	Detection of the SIMD instruction sets of the processor (and of their support by the
+/// 		operating system), used to select the kernels at run time: a single binary uses the
+/// 		full vector width of each machine.
+///
+/// 		The detection is done once, by the first call (call CpuFeatures::instructionSet at
+/// 		startup, before the rendering threads are started).
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class CpuFeatures
+{
+public:
+	/// \brief	The instruction sets of the kernels, ordered by vector width (the 256 bits kernels
+	/// 		only use AVX floating point instructions, AVX2 is not needed). The 128 bits kernels
+	/// 		are SSE2 kernels: the structure of arrays layout has no use of the SSE4.1 blends and
+	/// 		dot products.
+	enum InstructionSet { sse2, avx, avx512 } ;
+
+protected:
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static void CpuFeatures::cpuid(int leaf, int subleaf, unsigned int registers[4])
+	///
+	/// \brief	Executes the cpuid instruction.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \param	leaf			 	The leaf (eax).
+	/// \param	subleaf			 	The sub leaf (ecx).
+	/// \param [out]	registers	The eax, ebx, ecx and edx registers.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static void cpuid(int leaf, int subleaf, unsigned int registers[4])
+	{
+#ifdef _MSC_VER
+		int values[4] ;
+		__cpuidex(values, leaf, subleaf) ;
+		for(int cpt=0 ; cpt<4 ; ++cpt) { registers[cpt] = (unsigned int)values[cpt] ; }
+#else
+		__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]) ;
+#endif
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static unsigned long long CpuFeatures::enabledStates()
+	///
+	/// \brief	Reads the register states saved by the operating system (XCR0, only valid if the
+	/// 		processor reports OSXSAVE).
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \return	The XCR0 register.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static unsigned long long enabledStates()
+	{
+#ifdef _MSC_VER
+		return _xgetbv(0) ;
+#else
+		unsigned int eax, edx ;
+		__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0)) ;
+		return ((unsigned long long)edx<<32) | eax ;
+#endif
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static InstructionSet CpuFeatures::detect()
+	///
+	/// \brief	Detects the widest instruction set supported by the processor and the operating system.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \return	The instruction set.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static InstructionSet detect()
+	{
+		unsigned int registers[4] ;
+		cpuid(0, 0, registers) ;
+		unsigned int maxLeaf = registers[0] ;
+		cpuid(1, 0, registers) ;
+		// AVX needs the operating system to save the ymm registers (OSXSAVE, XCR0 bits 1 and 2)
+		bool avxSupported = (registers[2] & (1<<28))!=0 ;
+		bool osxsave = (registers[2] & (1<<27))!=0 ;
+		if(!avxSupported || !osxsave) { return sse2 ; }
+		unsigned long long states = enabledStates() ;
+		if((states & 0x6)!=0x6) { return sse2 ; }
+		if(maxLeaf>=7)
+		{
+			// AVX-512 also needs the opmask and zmm states (XCR0 bits 5 to 7)
+			cpuid(7, 0, registers) ;
+			if((registers[1] & (1<<16)) && (states & 0xe0)==0xe0) { return avx512 ; }
+		}
+		return avx ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static InstructionSet & CpuFeatures::selected()
+	///
+	/// \brief	The instruction set used by the kernels.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \return	The instruction set.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static InstructionSet & selected()
+	{
+		static InstructionSet instructionSet = detected() ;
+		return instructionSet ;
+	}
+
+public:
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static InstructionSet CpuFeatures::detected()
+	///
+	/// \brief	Gets the widest instruction set of the machine.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \return	The instruction set.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static InstructionSet detected()
+	{
+		static const InstructionSet instructionSet = detect() ;
+		return instructionSet ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static InstructionSet CpuFeatures::instructionSet()
+	///
+	/// \brief	Gets the instruction set used by the kernels (the detected one, unless limited by
+	/// 		CpuFeatures::limit). The traversals read it once and give it to the kernels (see
+	/// 		WideBoxTest and TriangleBlockTest).
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \return	The instruction set.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static InstructionSet instructionSet()
+	{
+		return selected() ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static void CpuFeatures::limit(InstructionSet instructionSet)
+	///
+	/// \brief	Limits the instruction set used by the kernels (comparisons, reproducibility). Must not
+	/// 		be called during a rendering.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \param	instructionSet	The widest instruction set to use.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static void limit(InstructionSet instructionSet)
+	{
+		selected() = ::std::min(instructionSet, detected()) ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	static const char * CpuFeatures::name(InstructionSet instructionSet)
+	///
+	/// \brief	Gets the name of an instruction set.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \param	instructionSet	The instruction set.
+	///
+	/// \return	The name.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	static const char * name(InstructionSet instructionSet)
+	{
+		static const char * names[] = { "SSE2", "AVX", "AVX-512" } ;
+		return names[instructionSet] ;
+	}
+} ;
+
+#endif
@@ -2,6 +2,10 @@
 #define _aligned_allocator_H
 
 #include <malloc.h>
+#ifndef _MSC_VER
+// Only Visual C++ declares _mm_malloc and _mm_free in malloc.h
+#include <mm_malloc.h>
+#endif
  
 /**
  * Allocator for aligned data.
@@ -0,0 +1,539 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Regression tests of the renderer: the acceleration structures (binary BVH, wide BVH, ray packets
+// and instances) are compared with a brute force intersection for each SIMD instruction set of the
+// machine, the samplers are checked and the sample budget of the adaptive sampling is verified.
+//
+// This program has its own main and is not part of RayCasting.vcxproj. From the RayCasting
+// directory:
+//   cl /O2 /openmp /EHsc /I. Test\regression.cpp
+//   g++ -std=c++11 -O2 -fopenmp -I. Test/regression.cpp -o regression
+// The program prints the failed checks and returns their number (0 if all the tests pass).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <Math/Vector3.h>
+#include <Geometry/Ray.h>
+#include <Geometry/Triangle.h>
+#include <Geometry/CastedRay.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <Geometry/RGBColor.h>
+#include <Geometry/Material.h>
+#include <Geometry/PointLight.h>
+#include <Geometry/Camera.h>
+#include <Visualizer/OffscreenTarget.h>
+#include <Geometry/Scene.h>
+#include <Geometry/BVH.h>
+#include <Geometry/FrameBuffer.h>
+#include <System/CpuFeatures.h>
+#include <Math/Quaternion.h>
+#include <Math/SobolSampler.h>
+#include <Math/HaltonSampler.h>
+#include <Math/RandomSampler.h>
+
+/// \brief	The number of failed checks.
+static int s_failures = 0 ;
+
+/// \brief	The random numbers of the tests (fixed seed: the tests are reproducible).
+static ::std::mt19937 s_random(12345) ;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	void check(bool condition, const char * test, int index)
+///
+/// \brief	Reports a failed check.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	condition	The condition that should be true.
+/// \param	test	 	The name of the check.
+/// \param	index	 	The index of the tested ray or value.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void check(bool condition, const char * test, int index)
+{
+	if(condition) { return ; }
+	++s_failures ;
+	::std::cout<<"FAILED: "<<test<<" ("<<CpuFeatures::name(CpuFeatures::instructionSet())<<", #"<<index<<")"<<::std::endl ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	float random(float low, float high)
+///
+/// \brief	Draws a uniform random number.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	low 	The lower bound.
+/// \param	high	The upper bound.
+///
+/// \return	A random number in [low, high).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+float random(float low, float high)
+{
+	return ::std::uniform_real_distribution<float>(low, high)(s_random) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	Math::Vector3 randomPoint(float extent)
+///
+/// \brief	Draws a random point in a cube centered on the origin.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	extent	The half size of the cube.
+///
+/// \return	The point.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Math::Vector3 randomPoint(float extent)
+{
+	return Math::Vector3(random(-extent, extent), random(-extent, extent), random(-extent, extent)) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	Geometry::Ray randomRay()
+///
+/// \brief	Draws a random ray crossing the test scenes.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \return	The ray.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Geometry::Ray randomRay()
+{
+	Math::Vector3 source = randomPoint(3.0f) ;
+	Math::Vector3 direction = randomPoint(0.5f)-source ;
+	return Geometry::Ray(source, direction/direction.norm()) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	::std::vector<Geometry::Ray> randomPacketRays(int count)
+///
+/// \brief	Draws the rays of a coherent packet: rays from a common source toward a small region, with
+/// 		directions of the same signs (see RayPacket::coherent).
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	count	The number of rays.
+///
+/// \return	The rays.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+::std::vector<Geometry::Ray> randomPacketRays(int count)
+{
+	Math::Vector3 source = randomPoint(3.0f) ;
+	Math::Vector3 target = randomPoint(0.5f) ;
+	::std::vector<Geometry::Ray> rays ;
+	while((int)rays.size()<count)
+	{
+		Math::Vector3 direction = target+randomPoint(0.2f)-source ;
+		Geometry::Ray ray(source, direction/direction.norm()) ;
+		if(!rays.empty() && (ray.getSign()[0]!=rays[0].getSign()[0] || ray.getSign()[1]!=rays[0].getSign()[1] || ray.getSign()[2]!=rays[0].getSign()[2])) { continue ; }
+		rays.push_back(ray) ;
+	}
+	return rays ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	Geometry::Geometry randomTriangles(int count, Geometry::Material * material)
+///
+/// \brief	Builds a soup of random triangles (overlapping, of various sizes and orientations).
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	count				The number of triangles.
+/// \param [in,out]	material	The material of the triangles.
+///
+/// \return	The geometry.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Geometry::Geometry randomTriangles(int count, Geometry::Material * material)
+{
+	Geometry::Geometry geometry ;
+	for(int cpt=0 ; cpt<count ; ++cpt)
+	{
+		Math::Vector3 center = randomPoint(1.0f) ;
+		float size = random(0.02f, 0.3f) ;
+		geometry.addTriangle(center+randomPoint(size), center+randomPoint(size), center+randomPoint(size), material) ;
+	}
+	return geometry ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	bool sameDistance(bool found, float t, bool expectedFound, float expected)
+///
+/// \brief	Compares an intersection with the brute force result.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	found		 	true if an intersection has been found.
+/// \param	t			 	The distance of the intersection.
+/// \param	expectedFound	true if the brute force found an intersection.
+/// \param	expected	 	The distance of the brute force intersection.
+///
+/// \return	true if both agree (up to the rounding errors of the transforms).
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool sameDistance(bool found, float t, bool expectedFound, float expected)
+{
+	if(found!=expectedFound) { return false ; }
+	return !found || fabs(t-expected)<=1e-4f*(1.0f+expected) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	class BruteForce
+///
+/// \brief	Nearest intersection by testing all the triangles and quadrics of a scene, in world space.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class BruteForce
+{
+protected:
+	/// \brief	The triangles (in world space).
+	::std::vector<Geometry::Triangle> m_triangles ;
+	/// \brief	The quadrics.
+	::std::vector<Geometry::Quadric> m_quadrics ;
+
+public:
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	void BruteForce::add(Geometry::Geometry const & geometry)
+	///
+	/// \brief	Adds the triangles of a geometry.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \param	geometry	The geometry.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	void add(Geometry::Geometry const & geometry)
+	{
+		m_triangles.insert(m_triangles.end(), geometry.getTriangles().begin(), geometry.getTriangles().end()) ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	void BruteForce::add(Geometry::Quadric const & quadric)
+	///
+	/// \brief	Adds a quadric.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \param	quadric	The quadric.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	void add(Geometry::Quadric const & quadric)
+	{
+		m_quadrics.push_back(quadric) ;
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \fn	bool BruteForce::intersection(Geometry::Ray const & ray, float & t) const
+	///
+	/// \brief	Computes the nearest intersection.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	///
+	/// \param	ray		 	The ray.
+	/// \param [out]	t	The distance of the nearest intersection.
+	///
+	/// \return	true if the ray hits the scene.
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool intersection(Geometry::Ray const & ray, float & t) const
+	{
+		t = ::std::numeric_limits<float>::max() ;
+		bool found = false ;
+		for(auto it=m_triangles.begin(), end=m_triangles.end() ; it!=end ; ++it)
+		{
+			float tTriangle, u, v ;
+			if(it->intersection(ray, tTriangle, u, v) && tTriangle<t)
+			{
+				t = tTriangle ;
+				found = true ;
+			}
+		}
+		for(auto it=m_quadrics.begin(), end=m_quadrics.end() ; it!=end ; ++it)
+		{
+			found |= it->intersection(ray, t) ;
+		}
+		return found ;
+	}
+} ;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	void testGeometry()
+///
+/// \brief	Compares the binary BVH, the wide BVH (Geometry::intersection and Geometry::occluded) and
+/// 		the packet traversal of a geometry with the brute force intersection.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void testGeometry()
+{
+	Geometry::Material material(Geometry::RGBColor(), Geometry::RGBColor(0.5f, 0.5f, 0.5f), Geometry::RGBColor(), Geometry::RGBColor(), 1.0f) ;
+	Geometry::Geometry geometry = randomTriangles(500, &material) ;
+	geometry.buildAccelerationStructure() ;
+	BruteForce bruteForce ;
+	bruteForce.add(geometry) ;
+	const auto & triangles = geometry.getTriangles() ;
+
+	// Binary hierarchy, traversed without triangle blocks
+	::std::vector<Geometry::BoundingBox, aligned_allocator<Geometry::BoundingBox, 16> > boxes ;
+	for(auto it=triangles.begin(), end=triangles.end() ; it!=end ; ++it)
+	{
+		Geometry::BoundingBox box ;
+		box.update(*it) ;
+		boxes.push_back(box) ;
+	}
+	Geometry::BVH bvh ;
+	bvh.build(boxes) ;
+
+	for(int cpt=0 ; cpt<2000 ; ++cpt)
+	{
+		Geometry::Ray ray = randomRay() ;
+		float expected ;
+		bool expectedFound = bruteForce.intersection(ray, expected) ;
+
+		float t = ::std::numeric_limits<float>::max() ;
+		auto intersector = [&](int primitive, float & tCurrent) -> bool
+		{
+			float tTriangle, u, v ;
+			if(!triangles[primitive].intersection(ray, tTriangle, u, v) || tTriangle>=tCurrent) { return false ; }
+			tCurrent = tTriangle ;
+			return true ;
+		} ;
+		bool found = bvh.intersect(ray, t, intersector) ;
+		check(sameDistance(found, t, expectedFound, expected), "BVH::intersect", cpt) ;
+
+		const Geometry::Triangle * triangle ;
+		float u, v ;
+		t = ::std::numeric_limits<float>::max() ;
+		found = geometry.intersection(ray, t, triangle, u, v) ;
+		check(sameDistance(found, t, expectedFound, expected), "WideBVH (Geometry::intersection)", cpt) ;
+
+		// Shadow ray stopped half way to the nearest intersection, or beyond it
+		if(expectedFound)
+		{
+			check(!geometry.occluded(ray, expected*0.5f), "Geometry::occluded (before the hit)", cpt) ;
+			check(geometry.occluded(ray, expected*1.01f+1e-3f), "Geometry::occluded (after the hit)", cpt) ;
+		}
+	}
+
+	// Coherent packets
+	for(int cpt=0 ; cpt<200 ; ++cpt)
+	{
+		const int size = PACKET_TILE_SIZE*PACKET_TILE_SIZE ;
+		::std::vector<Geometry::Ray> rays = randomPacketRays(size) ;
+		Geometry::RayPacket<size> packet(&rays[0], size) ;
+		geometry.intersection(packet) ;
+		for(int ray=0 ; ray<size ; ++ray)
+		{
+			float expected ;
+			bool expectedFound = bruteForce.intersection(rays[ray], expected) ;
+			bool found = packet.distance(ray)<::std::numeric_limits<float>::max() ;
+			check(sameDistance(found, packet.distance(ray), expectedFound, expected), "RayPacket (Geometry::intersection)", cpt*size+ray) ;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	void testScene()
+///
+/// \brief	Compares the intersections of a scene (top level hierarchy over transformed instances of a
+/// 		shared mesh and quadrics) with the brute force intersection, ray by ray and by packets.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void testScene()
+{
+	Geometry::Material material(Geometry::RGBColor(), Geometry::RGBColor(0.5f, 0.5f, 0.5f), Geometry::RGBColor(), Geometry::RGBColor(), 1.0f) ;
+	Visualizer::OffscreenTarget target(8, 8) ;
+	Geometry::Scene scene(&target) ;
+	BruteForce bruteForce ;
+
+	// Transformed copies are shared as instances of the first mesh (see Scene::add)
+	Geometry::Geometry mesh = randomTriangles(200, &material) ;
+	mesh.scale(0.5f) ;
+	for(int cpt=0 ; cpt<4 ; ++cpt)
+	{
+		Geometry::Geometry copy = mesh ;
+		if(cpt>0) { copy.rotate(Math::Quaternion(Math::Vector3(1.0f, 2.0f, 3.0f)/sqrt(14.0f), 0.7f*cpt)) ; }
+		if(cpt>1) { copy.scale(1.0f+0.7f*cpt) ; }
+		copy.translate(randomPoint(1.0f)) ;
+		scene.add(copy) ;
+		bruteForce.add(copy) ;
+	}
+	Geometry::Quadric sphere(Geometry::Quadric::sphere, &material) ;
+	sphere.scale(0.8f) ;
+	sphere.translate(Math::Vector3(0.3f, -0.4f, 0.2f)) ;
+	scene.add(sphere) ;
+	bruteForce.add(sphere) ;
+	Geometry::Quadric cylinder(Geometry::Quadric::cylinder, &material) ;
+	cylinder.scaleX(0.3f) ;
+	cylinder.translate(Math::Vector3(-0.6f, 0.5f, -0.3f)) ;
+	scene.add(cylinder) ;
+	bruteForce.add(cylinder) ;
+	scene.updateAccelerationStructure() ;
+
+	for(int cpt=0 ; cpt<2000 ; ++cpt)
+	{
+		Geometry::Ray ray = randomRay() ;
+		float expected ;
+		bool expectedFound = bruteForce.intersection(ray, expected) ;
+		Geometry::RayTriangleIntersection intersection = scene.rayIntersection(ray) ;
+		check(sameDistance(intersection.valid(), intersection.tRayValue(), expectedFound, expected), "Scene::rayIntersection (instances)", cpt) ;
+		if(expectedFound && expected>0.01f)
+		{
+			Math::Vector3 hit = ray.source()+ray.direction()*expected ;
+			check(!scene.occluded(ray.source(), ray.source()+ray.direction()*(expected*0.5f)), "Scene::occluded (before the hit)", cpt) ;
+			check(scene.occluded(ray.source(), hit+ray.direction()*(0.01f+expected*0.01f)), "Scene::occluded (after the hit)", cpt) ;
+		}
+	}
+
+	for(int cpt=0 ; cpt<200 ; ++cpt)
+	{
+		const int size = PACKET_TILE_SIZE*PACKET_TILE_SIZE ;
+		::std::vector<Geometry::Ray> rays = randomPacketRays(size) ;
+		Geometry::RayPacket<size> packet(&rays[0], size) ;
+		scene.rayIntersection(packet) ;
+		for(int ray=0 ; ray<size ; ++ray)
+		{
+			float expected ;
+			bool expectedFound = bruteForce.intersection(rays[ray], expected) ;
+			Geometry::RayTriangleIntersection intersection = packet.intersection(ray) ;
+			check(sameDistance(intersection.valid(), intersection.tRayValue(), expectedFound, expected), "RayPacket (Scene::rayIntersection)", cpt*size+ray) ;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	void testSampler(Math::Sampler const & sampler, const char * name)
+///
+/// \brief	Checks that a sampler only returns values in [0,1) and that its values are spread over
+/// 		the interval (mean and extreme values).
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	sampler	The sampler.
+/// \param	name   	The name of the check.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void testSampler(Math::Sampler const & sampler, const char * name)
+{
+	for(uint32_t dimension=0 ; dimension<32 ; ++dimension)
+	{
+		double sum = 0.0 ;
+		float low = 1.0f, high = 0.0f ;
+		int count = 0 ;
+		for(uint32_t pixel=0 ; pixel<64 ; pixel+=7)
+		{
+			for(uint32_t index=0 ; index<256 ; ++index)
+			{
+				float value = sampler.sample(pixel*1031u, index, dimension) ;
+				check(value>=0.0f && value<1.0f, name, (int)(dimension*65536+pixel*256+index)) ;
+				sum += value ;
+				low = ::std::min(low, value) ;
+				high = ::std::max(high, value) ;
+				++count ;
+			}
+		}
+		check(fabs(sum/count-0.5)<0.02 && low<0.01f && high>0.99f, name, (int)dimension) ;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	void testSampleBudget()
+///
+/// \brief	Checks FrameBuffer::limitActivePixels (number of kept pixels, pixels with the fewest
+/// 		samples first) and the sample budget of an adaptive rendering.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void testSampleBudget()
+{
+	const int width = 37, height = 23 ;
+	Geometry::FrameBuffer frameBuffer(width, height) ;
+	for(int y=0 ; y<height ; ++y)
+	{
+		for(int x=0 ; x<width ; ++x)
+		{
+			int samples = 1+(int)(s_random()%5) ;
+			for(int cpt=0 ; cpt<samples ; ++cpt) { frameBuffer.add(x, y, Geometry::RGBColor(random(0.0f, 1.0f), 0.5f, 0.5f)) ; }
+		}
+	}
+	int limits[] = { 0, 1, 100, 400, width*height-1, width*height, width*height+10 } ;
+	for(int cpt=0 ; cpt<(int)(sizeof(limits)/sizeof(limits[0])) ; ++cpt)
+	{
+		Geometry::FrameBuffer limited = frameBuffer ;
+		int active = limited.limitActivePixels(limits[cpt]) ;
+		int counted = 0 ;
+		int maxKept = 0, minDropped = ::std::numeric_limits<int>::max() ;
+		for(int y=0 ; y<height ; ++y)
+		{
+			for(int x=0 ; x<width ; ++x)
+			{
+				if(limited.active(x, y)) { ++counted ; maxKept = ::std::max(maxKept, limited.sampleCount(x, y)) ; }
+				else { minDropped = ::std::min(minDropped, limited.sampleCount(x, y)) ; }
+			}
+		}
+		check(active==::std::min(limits[cpt], width*height), "FrameBuffer::limitActivePixels (count)", cpt) ;
+		check(counted==active, "FrameBuffer::limitActivePixels (active pixels)", cpt) ;
+		check(maxKept<=minDropped, "FrameBuffer::limitActivePixels (fewest samples first)", cpt) ;
+	}
+
+	// Adaptive rendering: the samples never exceed the budget of the non adaptive rendering
+	Geometry::Material material(Geometry::RGBColor(), Geometry::RGBColor(0.5f, 0.5f, 0.5f), Geometry::RGBColor(), Geometry::RGBColor(1.0f, 1.0f, 1.0f), 1.0f) ;
+	Visualizer::OffscreenTarget target(24, 24) ;
+	Geometry::Scene scene(&target) ;
+	scene.add(randomTriangles(100, &material)) ;
+	scene.setCamera(Geometry::Camera(Math::Vector3(-4.0f, 0.0f, 0.0f), Math::Vector3(0.0f, 0.0f, 0.0f), 0.3f, 1.0f, 1.0f)) ;
+	scene.setRenderMode(Geometry::Scene::pathTracing) ;
+	const int samplesPerPixel = 6 ;
+	scene.setSamplesPerPixel(samplesPerPixel) ;
+	scene.setAdaptiveSampling(0.001f, 2, 32) ;
+	scene.compute(2) ;
+	int samples = 0 ;
+	for(int y=0 ; y<target.height() ; ++y)
+	{
+		for(int x=0 ; x<target.width() ; ++x)
+		{
+			samples += scene.frameBuffer().sampleCount(x, y) ;
+		}
+	}
+	check(samples<=samplesPerPixel*target.width()*target.height(), "Scene::compute (adaptive sample budget)", samples) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char ** argv)
+{
+	// 1 - Acceleration structures, with each instruction set of the machine
+	for(int instructionSet=CpuFeatures::sse2 ; instructionSet<=CpuFeatures::detected() ; ++instructionSet)
+	{
+		CpuFeatures::limit((CpuFeatures::InstructionSet)instructionSet) ;
+		::std::cout<<"Intersections: "<<CpuFeatures::name(CpuFeatures::instructionSet())<<::std::endl ;
+		testGeometry() ;
+		testScene() ;
+	}
+	CpuFeatures::limit(CpuFeatures::detected()) ;
+
+	// 2 - Samplers
+	::std::cout<<"Samplers"<<::std::endl ;
+	testSampler(Math::SobolSampler(), "SobolSampler") ;
+	testSampler(Math::HaltonSampler(), "HaltonSampler") ;
+	testSampler(Math::RandomSampler(), "RandomSampler") ;
+
+	// 3 - Adaptive sampling
+	::std::cout<<"Sample budget"<<::std::endl ;
+	testSampleBudget() ;
+
+	::std::cout<<s_failures<<" failed check(s)"<<::std::endl ;
+	return s_failures ;
+}
@@ -0,0 +1,139 @@
+#ifndef _Visualizer_OffscreenTarget_H
+#define _Visualizer_OffscreenTarget_H
+
+#include <vector>
+#include <stdio.h>
+#include <Visualizer/RenderTarget.h>
+
+namespace Visualizer
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	OffscreenTarget
+	///
+	/// \brief	A render target in memory, for renderings without display. The image can be saved in a
+	/// 		binary PPM file.
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class OffscreenTarget : public RenderTarget
+	{
+	protected:
+		/// \brief	Image width.
+		int m_width ;
+		/// \brief	Image height.
+		int m_height ;
+		/// \brief	The tone mapped pixels (RGB, line by line).
+		::std::vector<unsigned char> m_pixels ;
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	OffscreenTarget::OffscreenTarget(int width, int height)
+		///
+		/// \brief	Constructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	width 	The width of the image.
+		/// \param	height	The height of the image.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		OffscreenTarget(int width, int height)
+			: m_width(width), m_height(height), m_pixels(width*height*3, 0)
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual int OffscreenTarget::width() const
+		///
+		/// \brief	Gets the width of the image.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The width in pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual int width() const
+		{ return m_width ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual int OffscreenTarget::height() const
+		///
+		/// \brief	Gets the height of the image.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The height in pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual int height() const
+		{ return m_height ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual void OffscreenTarget::plot(int x, int y, const Geometry::RGBColor color)
+		///
+		/// \brief	Changes the color of a pixel (simple tone mapper).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	 	The x coordinate of the pixel.
+		/// \param	y	 	The y coordinate of the pixel.
+		/// \param	color	The color.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual void plot(int x, int y, const Geometry::RGBColor color)
+		{
+			unsigned char * pixel = &m_pixels[(y*m_width+x)*3] ;
+			pixel[0] = toneMap(color[0]) ;
+			pixel[1] = toneMap(color[1]) ;
+			pixel[2] = toneMap(color[2]) ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual void OffscreenTarget::update()
+		///
+		/// \brief	Nothing to present: the image is always up to date.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual void update()
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	const unsigned char * OffscreenTarget::pixels() const
+		///
+		/// \brief	Gets the tone mapped pixels (RGB, line by line).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		const unsigned char * pixels() const
+		{ return &m_pixels[0] ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	bool OffscreenTarget::save(const char * fileName) const
+		///
+		/// \brief	Saves the image in a binary PPM file.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	fileName	The name of the file.
+		///
+		/// \return	true if the file has been written.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		bool save(const char * fileName) const
+		{
+			FILE * file = fopen(fileName, "wb") ;
+			if(file==NULL) { return false ; }
+			fprintf(file, "P6\n%d %d\n255\n", m_width, m_height) ;
+			size_t written = fwrite(&m_pixels[0], 1, m_pixels.size(), file) ;
+			fclose(file) ;
+			return written==m_pixels.size() ;
+		}
+	} ;
+}
+
+#endif
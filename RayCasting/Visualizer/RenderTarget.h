@@ -0,0 +1,210 @@
+#ifndef _Visualizer_RenderTarget_H
+#define _Visualizer_RenderTarget_H
+
+#include <vector>
+#include <Geometry/RGBColor.h>
+#include <Geometry/FrameBuffer.h>
+
+namespace Visualizer
+{
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// \class	RenderTarget
+	///
+	/// \brief	The destination of a rendering: a window (Visualizer::Visualizer) or an image in memory
+	/// 		(Visualizer::OffscreenTarget). The rendering threads never access the target: a single
+	/// 		thread periodically presents a frame buffer that is not being written (see
+	/// 		RenderTarget::present).
+	///
+	/// \author	A. Roca, Universit de Rennes 1
+	/// \date	16/10/2026
+	////////////////////////////////////////////////////////////////////////////////////////////////////
+	class RenderTarget
+	{
+	protected:
+		/// \brief	The colors of the last presented snapshot (frame buffer or image).
+		::std::vector<Geometry::RGBColor> m_snapshot ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	static unsigned char RenderTarget::toneMap(float value)
+		///
+		/// \brief	A simple tone mapper (v/(v+1)).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	value	The value of a color component.
+		///
+		/// \return	The tone mapped value [0..255].
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		static unsigned char toneMap(float value)
+		{
+			return (unsigned char)(value/(value+1)*255) ;
+		}
+
+	public:
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual RenderTarget::~RenderTarget()
+		///
+		/// \brief	Destructor.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual ~RenderTarget()
+		{}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual int RenderTarget::width() const = 0
+		///
+		/// \brief	Gets the width of the target.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The width in pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual int width() const = 0 ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual int RenderTarget::height() const = 0
+		///
+		/// \brief	Gets the height of the target.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	The height in pixels.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual int height() const = 0 ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual void RenderTarget::plot(int x, int y, const Geometry::RGBColor color) = 0
+		///
+		/// \brief	Changes the color of a pixel (HDR color, tone mapped by the target).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	x	 	The x coordinate of the pixel.
+		/// \param	y	 	The y coordinate of the pixel.
+		/// \param	color	The color.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual void plot(int x, int y, const Geometry::RGBColor color) = 0 ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual void RenderTarget::update() = 0
+		///
+		/// \brief	Presents the plotted pixels.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual void update() = 0 ;
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual bool RenderTarget::quitRequested() const
+		///
+		/// \brief	Tests if the user asked to stop the rendering (see RenderTarget::update).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true to stop the rendering.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual bool quitRequested() const
+		{ return false ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual bool RenderTarget::interactive() const
+		///
+		/// \brief	Tests if the target is presented to the user during the rendering. Non interactive
+		/// 		targets only need the final image (see Scene::compute).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true if the rendering is presented while it is computed.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual bool interactive() const
+		{ return false ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RenderTarget::snapshot(Geometry::FrameBuffer const & frameBuffer)
+		///
+		/// \brief	Copies the mean colors of the pixels of a frame buffer in the snapshot, presented by
+		/// 		RenderTarget::presentSnapshot. The frame buffer must not be written during the copy.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	frameBuffer	The frame buffer (same size as the target).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void snapshot(Geometry::FrameBuffer const & frameBuffer)
+		{
+			m_snapshot.resize(width()*height()) ;
+			for(int y=0 ; y<height() ; ++y)
+			{
+				for(int x=0 ; x<width() ; ++x)
+				{
+					m_snapshot[y*width()+x] = frameBuffer.color(x, y) ;
+				}
+			}
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RenderTarget::present(Geometry::FrameBuffer const & frameBuffer)
+		///
+		/// \brief	Presents a frame buffer: the mean colors of the pixels are copied in the snapshot,
+		/// 		then tone mapped in the target and the target is updated. The frame buffer must not
+		/// 		be written during the call.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	frameBuffer	The frame buffer (same size as the target).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void present(Geometry::FrameBuffer const & frameBuffer)
+		{
+			snapshot(frameBuffer) ;
+			presentSnapshot() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RenderTarget::present(::std::vector<Geometry::RGBColor> const & image)
+		///
+		/// \brief	Presents an image (for instance a denoised frame buffer, see Geometry::Denoiser).
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \param	image	The colors of the pixels, line by line (same size as the target).
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void present(::std::vector<Geometry::RGBColor> const & image)
+		{
+			m_snapshot = image ;
+			presentSnapshot() ;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	void RenderTarget::presentSnapshot()
+		///
+		/// \brief	Plots the snapshot in the target and updates the target.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		void presentSnapshot()
+		{
+			for(int y=0 ; y<height() ; ++y)
+			{
+				for(int x=0 ; x<width() ; ++x)
+				{
+					plot(x, y, m_snapshot[y*width()+x]) ;
+				}
+			}
+			update() ;
+		}
+	} ;
+}
+
+#endif
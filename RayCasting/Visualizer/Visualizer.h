@@ -5,6 +5,7 @@
 #include <SDL_draw.h>
 #include <iostream>
 #include <Geometry/RGBColor.h>
+#include <Visualizer/RenderTarget.h>
 
 namespace Visualizer
 {
@@ -13,12 +14,12 @@ namespace Visualizer
 	////////////////////////////////////////////////////////////////////////////////////////////////////
 	/// \class	Visualizer
 	///
-	/// \brief	Opens a 2D rendering context.
+	/// \brief	Opens a 2D rendering context (SDL window render target).
 	///
 	/// \author	F. Lamarche, Universit de Rennes 1
 	/// \date	03/12/2013
 	////////////////////////////////////////////////////////////////////////////////////////////////////
-	class Visualizer
+	class Visualizer : public RenderTarget
 	{
 	protected:
 		/// \brief	The rendering context.
@@ -27,6 +28,9 @@ namespace Visualizer
 		int m_width ;
 		/// \brief	Window height.
 		int m_height ;
+		/// \brief	true if a key has been pressed or the window has been closed. Only accessed by the
+		/// 		presentation thread (see Scene::present).
+		bool m_quitRequested ;
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		/// \fn	Uint32 Visualizer::FastestFlags(Uint32 flags, unsigned int width, unsigned int height,
@@ -82,7 +86,7 @@ namespace Visualizer
 		/// \param	height	The height of the rendering window.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
 		Visualizer(int width, int height)
-			: m_width(width), m_height(height) 
+			: m_width(width), m_height(height), m_quitRequested(false)
 		{
 			if(SDL_Init(SDL_INIT_VIDEO)<0) 
 			{
@@ -115,7 +119,7 @@ namespace Visualizer
 		///
 		/// \return	.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		int width() const
+		virtual int width() const
 		{ return m_width ; }
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -128,7 +132,7 @@ namespace Visualizer
 		///
 		/// \return	.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		int height() const
+		virtual int height() const
 		{ return m_height ; }
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -153,7 +157,7 @@ namespace Visualizer
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	void Visualizer::plot(int x, int y, const RGBColor color) const
+		/// \fn	virtual void Visualizer::plot(int x, int y, const RGBColor color)
 		///
 		/// \brief	Plots with a simple tone mapper
 		///
@@ -164,29 +168,29 @@ namespace Visualizer
 		/// \param	y	 	The y coordinate.
 		/// \param	color	The color.
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		void plot(int x, int y, const Geometry::RGBColor color) const
+		virtual void plot(int x, int y, const Geometry::RGBColor color)
 		{
 			// A Simple tone mapper
-			unsigned char r = color[0]/(color[0]+1)*255 ;
-			unsigned char g = color[1]/(color[1]+1)*255 ;
-			unsigned char b = color[2]/(color[2]+1)*255 ;
+			unsigned char r = toneMap(color[0]) ;
+			unsigned char g = toneMap(color[1]) ;
+			unsigned char b = toneMap(color[2]) ;
 			// Maps the result into the rendering context
 			Uint32 renderedColor = SDL_MapRGB(screen->format, r, g, b) ;
 			Draw_Pixel(screen, (Sint16)x, (Sint16)y, renderedColor) ;
 		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		/// \fn	void Visualizer::update()
+		/// \fn	virtual void Visualizer::update()
 		///
 		/// \brief	Updates the rendering context.
 		///
-		/// \warning No modification is visible until this method is called. Application exists if any
-		/// 		 key is pressed.
+		/// \warning No modification is visible until this method is called. A rendering stop is
+		/// 		 requested if any key is pressed (see Visualizer::quitRequested).
 		/// 
 		/// \author	F. Lamarche, Universit de Rennes 1
 		/// \date	03/12/2013
 		////////////////////////////////////////////////////////////////////////////////////////////////////
-		void update()
+		virtual void update()
 		{
 			SDL_UpdateRect(screen, 0, 0, 0, 0);
 			SDL_Event event;
@@ -195,13 +199,39 @@ namespace Visualizer
 				case SDL_KEYDOWN:
 					/*break;*/
 				case SDL_QUIT:
-					exit(0) ;
+					m_quitRequested = true ;
 					break;
 				default:
 					break;
 				}
 			}/*while*/
 		}
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual bool Visualizer::quitRequested() const
+		///
+		/// \brief	Tests if a key has been pressed or the window closed during an update.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true to stop the rendering.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual bool quitRequested() const
+		{ return m_quitRequested ; }
+
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		/// \fn	virtual bool Visualizer::interactive() const
+		///
+		/// \brief	The window is presented during the rendering.
+		///
+		/// \author	A. Roca, Universit de Rennes 1
+		/// \date	16/10/2026
+		///
+		/// \return	true.
+		////////////////////////////////////////////////////////////////////////////////////////////////////
+		virtual bool interactive() const
+		{ return true ; }
 	} ;
 }
 
@@ -4,6 +4,7 @@
 #include <Geometry/CastedRay.h>
 #include <stdlib.h>
 #include <iostream>
+#include <string>
 #include <Geometry/RGBColor.h>
 #include <Geometry/Material.h>
 #include <Geometry/PointLight.h>
@@ -12,10 +13,18 @@
 #include <Geometry/Disk.h>
 #include <Geometry/Cylinder.h>
 #include <Geometry/Cone.h>
+// Define NO_SDL to build without SDL (headless rendering nodes): only the offscreen rendering is
+// available and the program does not need the SDL libraries to link or run.
+#ifndef NO_SDL
 #include <Visualizer/Visualizer.h>
+#endif
+#include <Visualizer/OffscreenTarget.h>
 #include <Geometry/Scene.h>
 #include <Geometry/Cornel.h>
 #include <Geometry/BoundingBox.h>
+#include <System/CpuFeatures.h>
+#include <Math/HaltonSampler.h>
+#include <Math/RandomSampler.h>
 //#include <omp.h>
 
 //Test
@@ -131,7 +140,8 @@ void initDiffuseSpecular(Geometry::Scene & scene)
 	tmp3.translate(Math::Vector3(3,-1.5,0.0));
 	scene.add(tmp3);
 
-	Geometry::Disk tmp4(20,transparent);
+	// Analytic disk: intersected in closed form instead of 20 triangles
+	Geometry::Quadric tmp4(Geometry::Quadric::disk, transparent);
 	tmp4.translate(Math::Vector3(0.5, 1, -3));
 	scene.add(tmp4);
 }
@@ -169,6 +179,7 @@ void initGlobal(Geometry::Scene & scene)
 	scene.add(tmp3);
 }
 
+#ifndef NO_SDL
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \fn	void waitKeyPressed()
 ///
@@ -195,11 +206,14 @@ void waitKeyPressed()
     }/*while*/
   }/*while(!done)*/
 }
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \fn	int main(int argc, char ** argv)
 ///
-/// \brief	Main entry-point for this application.
+/// \brief	Main entry-point for this application. With "-offscreen file.ppm", the scene is rendered
+/// 		without display and the image is saved in the provided file (the only mode available if
+/// 		NO_SDL is defined).
 ///
 /// \author	F. Lamarche, Universit de Rennes 1
 /// \date	03/12/2013
@@ -208,18 +222,88 @@ void waitKeyPressed()
 /// \param	argv	Array of command-line argument strings.
 ///
 /// \return	Exit-code for the process - 0 for success, else an error code.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \fn	void printUsage(const char * program)
+///
+/// \brief	Prints the command line switches of the program.
+///
+/// \author	A. Roca, Universit de Rennes 1
+/// \date	16/10/2026
+///
+/// \param	program	The name of the program.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void printUsage(const char * program)
+{
+	::std::cerr<<"Usage: "<<program<<" [options]"<<::std::endl
+		<<"  -offscreen file.ppm                  renders without window and saves the image"<<::std::endl
+		<<"  -mode recursive|path|wavefront       rendering algorithm (default: recursive)"<<::std::endl
+		<<"  -depth n                             maximum depth (default: 2)"<<::std::endl
+		<<"  -spp n                               samples per pixel of the path tracing modes"<<::std::endl
+		<<"  -adaptive error                      adaptive sampling with the target relative error"<<::std::endl
+		<<"  -denoise                             denoises the path traced image"<<::std::endl
+		<<"  -sampler sobol|halton|random         sampler of the path tracing modes (default: sobol)"<<::std::endl ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 int main(int argc, char ** argv)
 {
 	 //omp_set_num_threads(8);
 
-	// 1 - Initializes a window for rendering
-	//Visualizer::Visualizer visu(600,600) ;
-	Visualizer::Visualizer visu(300,300) ;
-	//Visualizer::Visualizer visu(200,200) ;
+	// 0 - Parses the command line
+	const char * offscreenFile = NULL ;
+	Geometry::Scene::RenderMode renderMode = Geometry::Scene::recursiveRendering ;
+	int maxDepth = 2 ;
+	int samplesPerPixel = 0 ;
+	float adaptiveError = 0.0f ;
+	bool denoise = false ;
+	static Math::HaltonSampler haltonSampler ;
+	static Math::RandomSampler randomSampler ;
+	const Math::Sampler * sampler = NULL ;
+	for(int cpt=1 ; cpt<argc ; ++cpt)
+	{
+		::std::string option(argv[cpt]) ;
+		bool hasValue = cpt+1<argc ;
+		::std::string value = hasValue ? argv[cpt+1] : "" ;
+		if(option=="-denoise") { denoise = true ; continue ; }
+		if(!hasValue) { printUsage(argv[0]) ; return 1 ; }
+		++cpt ;
+		if(option=="-offscreen") { offscreenFile = argv[cpt] ; }
+		else if(option=="-mode" && value=="recursive") { renderMode = Geometry::Scene::recursiveRendering ; }
+		else if(option=="-mode" && value=="path") { renderMode = Geometry::Scene::pathTracing ; }
+		else if(option=="-mode" && value=="wavefront") { renderMode = Geometry::Scene::wavefrontPathTracing ; }
+		else if(option=="-depth" && atoi(argv[cpt])>0) { maxDepth = atoi(argv[cpt]) ; }
+		else if(option=="-spp" && atoi(argv[cpt])>0) { samplesPerPixel = atoi(argv[cpt]) ; }
+		else if(option=="-adaptive" && atof(argv[cpt])>0.0) { adaptiveError = (float)atof(argv[cpt]) ; }
+		else if(option=="-sampler" && value=="sobol") { sampler = NULL ; }
+		else if(option=="-sampler" && value=="halton") { sampler = &haltonSampler ; }
+		else if(option=="-sampler" && value=="random") { sampler = &randomSampler ; }
+		else { printUsage(argv[0]) ; return 1 ; }
+	}
+
+	// 0.1 - Detects the SIMD instruction sets before the rendering threads are started
+	::std::cout<<"SIMD kernels: "<<CpuFeatures::name(CpuFeatures::instructionSet())<<::std::endl ;
+
+	// 1 - Initializes a window (or an offscreen image) for rendering
+	Visualizer::RenderTarget * visu ;
+	if(offscreenFile!=NULL)
+	{
+		visu = new Visualizer::OffscreenTarget(300,300) ;
+	}
+	else
+	{
+#ifdef NO_SDL
+		::std::cerr<<"Built without SDL, the -offscreen switch is required"<<::std::endl ;
+		printUsage(argv[0]) ;
+		return 1 ;
+#else
+		//visu = new Visualizer::Visualizer(600,600) ;
+		visu = new Visualizer::Visualizer(300,300) ;
+		//visu = new Visualizer::Visualizer(200,200) ;
+#endif
+	}
 
 	// 2 - Initializes the scene
-	Geometry::Scene scene(&visu) ;
+	Geometry::Scene scene(visu) ;
 
 	// 2.1 intializes the geometry (choose only one initialization)
 	int choix = 0;
@@ -270,11 +354,39 @@ int main(int argc, char ** argv)
 		scene.setCamera(camera) ;
 	}
 
+	// 2.3 Selects the rendering algorithm
+	scene.setRenderMode(renderMode) ;
+	if(samplesPerPixel>0)
+	{
+		scene.setSamplesPerPixel(samplesPerPixel) ;
+	}
+	if(adaptiveError>0.0f)
+	{
+		scene.setAdaptiveSampling(adaptiveError) ;
+	}
+	scene.useDenoiser(denoise) ;
+	scene.setSampler(sampler) ;
+
 	// 3 - Computes the scene
-	scene.compute(2);
+	scene.compute(maxDepth);
 
-	// 4 - waits until a key is pressed
-	waitKeyPressed();
+	// 4 - saves the image or waits until a key is pressed
+	if(offscreenFile!=NULL)
+	{
+		if(!static_cast<Visualizer::OffscreenTarget*>(visu)->save(offscreenFile))
+		{
+			::std::cerr<<"Unable to write "<<offscreenFile<<::std::endl ;
+			delete visu ;
+			return 1 ;
+		}
+	}
+#ifndef NO_SDL
+	else if(!visu->quitRequested())
+	{
+		waitKeyPressed();
+	}
+#endif
+	delete visu ;
 	
 	return 0 ;
 }
\ No newline at end of file